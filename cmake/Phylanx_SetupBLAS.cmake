@@ -0,0 +1,58 @@
+# Copyright (c) 2026 agent
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# setup an optimized CBLAS/LAPACKE implementation (OpenBLAS or the reference
+# implementation) as a dependency, the libraries are collected in
+# PHYLANX_BLAS_LIBRARIES
+macro(phylanx_setup_blas)
+
+  find_package(BLAS REQUIRED)
+  find_package(LAPACK REQUIRED)
+  if(NOT BLAS_FOUND OR NOT LAPACK_FOUND)
+    phylanx_error("BLAS/LAPACK could not be found, please set "
+      "BLA_VENDOR or CMAKE_PREFIX_PATH to help locating them.")
+  endif()
+
+  find_path(PHYLANX_CBLAS_INCLUDE_DIR cblas.h
+    PATH_SUFFIXES openblas)
+  find_path(PHYLANX_LAPACKE_INCLUDE_DIR lapacke.h
+    PATH_SUFFIXES openblas)
+  if(NOT PHYLANX_CBLAS_INCLUDE_DIR OR NOT PHYLANX_LAPACKE_INCLUDE_DIR)
+    phylanx_error("The headers cblas.h and lapacke.h could not be found, "
+      "please set PHYLANX_CBLAS_INCLUDE_DIR and PHYLANX_LAPACKE_INCLUDE_DIR.")
+  endif()
+  include_directories(
+    ${PHYLANX_CBLAS_INCLUDE_DIR} ${PHYLANX_LAPACKE_INCLUDE_DIR})
+
+  set(PHYLANX_BLAS_LIBRARIES ${LAPACK_LIBRARIES} ${BLAS_LIBRARIES})
+
+  # the reference implementations ship the C interfaces in separate libraries
+  find_library(PHYLANX_LAPACKE_LIBRARY lapacke)
+  if(PHYLANX_LAPACKE_LIBRARY)
+    set(PHYLANX_BLAS_LIBRARIES
+      ${PHYLANX_LAPACKE_LIBRARY} ${PHYLANX_BLAS_LIBRARIES})
+  endif()
+  find_library(PHYLANX_CBLAS_LIBRARY cblas)
+  if(PHYLANX_CBLAS_LIBRARY)
+    set(PHYLANX_BLAS_LIBRARIES
+      ${PHYLANX_BLAS_LIBRARIES} ${PHYLANX_CBLAS_LIBRARY})
+  endif()
+
+  add_definitions(-DPHYLANX_HAVE_BLAS)
+
+  # OpenBLAS is restricted to a single thread, HPX runs the BLAS calls
+  # concurrently instead
+  include(CheckSymbolExists)
+  set(CMAKE_REQUIRED_LIBRARIES ${PHYLANX_BLAS_LIBRARIES})
+  check_symbol_exists(openblas_set_num_threads
+    "${PHYLANX_CBLAS_INCLUDE_DIR}/cblas.h" PHYLANX_HAVE_OPENBLAS)
+  unset(CMAKE_REQUIRED_LIBRARIES)
+  if(PHYLANX_HAVE_OPENBLAS)
+    add_definitions(-DPHYLANX_HAVE_OPENBLAS)
+  endif()
+
+  phylanx_info("BLAS/LAPACK was found: " "${PHYLANX_BLAS_LIBRARIES}")
+
+endmacro()
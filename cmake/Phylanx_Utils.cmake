@@ -35,5 +35,6 @@ phylanx_include(
   SetupHPX
   SetupEigen3
   SetupBlaze
+  SetupBLAS
   SetupPybind11
 )
@@ -20,6 +20,7 @@
 #include <boost/spirit/include/support_attributes.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <list>
 #include <string>
@@ -210,6 +211,9 @@ namespace phylanx { namespace ast
           , std::int64_t
           , std::string
           , phylanx::ir::node_data<double>
+          , phylanx::ir::node_data<float>
+          , phylanx::ir::node_data<std::int64_t>
+          , phylanx::ir::node_data<std::uint8_t>
         >;
 
     // a literal value is valid of its not nil{}
@@ -12,15 +12,25 @@
 
 #include <hpx/util/tuple.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace phylanx { namespace execution_tree
 {
     ///////////////////////////////////////////////////////////////////////////
     /// Retrieve the full list of known patterns to be used with any of the
-    /// \a generate_tree functions below.
-    PHYLANX_EXPORT pattern_list const& get_all_known_patterns();
+    /// \a generate_tree functions below. This includes all patterns added
+    /// using \a register_patterns.
+    PHYLANX_EXPORT pattern_list get_all_known_patterns();
+
+    /// Add the given patterns to the list of known patterns used by the
+    /// \a generate_tree functions which don't take an explicit list of
+    /// patterns. The patterns are parsed once, here.
+    PHYLANX_EXPORT void register_patterns(
+        std::vector<match_pattern_type> const& patterns);
 
     namespace detail
     {
@@ -31,14 +41,59 @@ namespace phylanx { namespace execution_tree
             >;
         using expression_pattern_list = std::vector<expression_pattern>;
 
+        // Convert the given patterns into their parsed form. Each distinct
+        // pattern string is parsed only once, the result is cached.
         PHYLANX_EXPORT expression_pattern_list generate_patterns(
             pattern_list const& patterns_list);
 
+        ///////////////////////////////////////////////////////////////////////
+        // Parsed patterns indexed by the shape of their root node (the
+        // operator of binary and unary operations, the name of a called
+        // function). This allows to try only the patterns which could
+        // possibly match a given expression, in the order of the list.
+        class indexed_pattern_list
+        {
+        public:
+            PHYLANX_EXPORT explicit indexed_pattern_list(
+                expression_pattern_list patterns);
+
+            expression_pattern_list const& patterns() const
+            {
+                return patterns_;
+            }
+
+            // Return the (ordered) indices of all patterns which could match
+            // the given expression.
+            PHYLANX_EXPORT std::vector<std::size_t> const& candidates(
+                ast::expression const& expr) const;
+
+        private:
+            expression_pattern_list patterns_;
+
+            // patterns with a specific root node (merged with the wildcards)
+            std::unordered_map<std::string, std::vector<std::size_t>> index_;
+
+            std::vector<std::size_t> wildcards_;        // e.g. '_1'
+            std::vector<std::size_t> call_wildcards_;   // e.g. '_1(__2)'
+            std::vector<std::size_t> all_;
+        };
+
+        // Retrieve the parsed form of all known patterns. The list is built
+        // once and is never modified, registering new patterns replaces it.
+        PHYLANX_EXPORT std::shared_ptr<indexed_pattern_list const>
+            get_all_known_expression_patterns();
+
         PHYLANX_EXPORT primitive_argument_type generate_tree(
             ast::expression const& expr,
             expression_pattern_list const& patterns,
             phylanx::execution_tree::variables& variables,
             phylanx::execution_tree::functions& functions);
+
+        PHYLANX_EXPORT primitive_argument_type generate_tree(
+            ast::expression const& expr,
+            indexed_pattern_list const& patterns,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions);
     }
 
     /// Generate an expression tree corresponding to the given textual
@@ -8,7 +8,11 @@
 
 #include <phylanx/execution_tree/primitives/add_operation.hpp>
 #include <phylanx/execution_tree/primitives/and_operation.hpp>
+#include <phylanx/execution_tree/primitives/bicgstab.hpp>
 #include <phylanx/execution_tree/primitives/block_operation.hpp>
+#include <phylanx/execution_tree/primitives/cholesky_factorization.hpp>
+#include <phylanx/execution_tree/primitives/common_subexpression.hpp>
+#include <phylanx/execution_tree/primitives/conjugate_gradient.hpp>
 #include <phylanx/execution_tree/primitives/constant.hpp>
 #include <phylanx/execution_tree/primitives/define.hpp>
 #include <phylanx/execution_tree/primitives/determinant.hpp>
@@ -19,17 +23,24 @@
 #include <phylanx/execution_tree/primitives/file_read.hpp>
 #include <phylanx/execution_tree/primitives/file_write.hpp>
 #include <phylanx/execution_tree/primitives/for_operation.hpp>
+#include <phylanx/execution_tree/primitives/fused_operation.hpp>
 #include <phylanx/execution_tree/primitives/greater.hpp>
 #include <phylanx/execution_tree/primitives/greater_equal.hpp>
 #include <phylanx/execution_tree/primitives/if_conditional.hpp>
 #include <phylanx/execution_tree/primitives/inverse_operation.hpp>
+#include <phylanx/execution_tree/primitives/last_use.hpp>
 #include <phylanx/execution_tree/primitives/less.hpp>
 #include <phylanx/execution_tree/primitives/less_equal.hpp>
+#include <phylanx/execution_tree/primitives/loop_invariant.hpp>
+#include <phylanx/execution_tree/primitives/lu_decompose.hpp>
+#include <phylanx/execution_tree/primitives/lu_factorization.hpp>
 #include <phylanx/execution_tree/primitives/mul_operation.hpp>
 #include <phylanx/execution_tree/primitives/not_equal.hpp>
 #include <phylanx/execution_tree/primitives/or_operation.hpp>
 #include <phylanx/execution_tree/primitives/parallel_block_operation.hpp>
+#include <phylanx/execution_tree/primitives/qr_decompose.hpp>
 #include <phylanx/execution_tree/primitives/random.hpp>
+#include <phylanx/execution_tree/primitives/solve_operation.hpp>
 #include <phylanx/execution_tree/primitives/store_operation.hpp>
 #include <phylanx/execution_tree/primitives/sub_operation.hpp>
 #include <phylanx/execution_tree/primitives/transpose_operation.hpp>
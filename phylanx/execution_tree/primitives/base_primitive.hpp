@@ -15,8 +15,10 @@
 #include <hpx/include/components.hpp>
 #include <hpx/include/util.hpp>
 
+#include <cstdint>
 #include <initializer_list>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -44,6 +46,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
         virtual hpx::future<primitive_result_type> eval() const = 0;
 
+        hpx::future<primitive_result_type> eval_last_use_nonvirtual()
+        {
+            return eval_last_use();
+        }
+
+        // Evaluate the primitive for the last time before a new value is
+        // stored to it. Primitives holding a value may hand it over to the
+        // caller instead of sharing it.
+        virtual hpx::future<primitive_result_type> eval_last_use()
+        {
+            return eval();
+        }
+
         void store_nonvirtual(primitive_result_type const& data)
         {
             store(data);
@@ -58,6 +73,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     public:
         HPX_DEFINE_COMPONENT_ACTION(base_primitive, eval_nonvirtual, eval_action);
         HPX_DEFINE_COMPONENT_ACTION(base_primitive, store_nonvirtual, store_action);
+        HPX_DEFINE_COMPONENT_ACTION(base_primitive, eval_last_use_nonvirtual,
+            eval_last_use_action);
     };
 }}}
 
@@ -68,6 +85,9 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     phylanx::execution_tree::primitives::base_primitive::store_action,
     phylanx_primitive_store_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    phylanx::execution_tree::primitives::base_primitive::eval_last_use_action,
+    phylanx_primitive_eval_last_use_action);
 
 namespace phylanx { namespace execution_tree
 {
@@ -96,10 +116,57 @@ namespace phylanx { namespace execution_tree
         {
         }
 
+        primitive(primitive const& rhs)
+          : base_type(rhs)
+          , ptr_(std::atomic_load(&rhs.ptr_))
+        {
+        }
+        primitive(primitive && rhs)
+          : base_type(std::move(rhs))
+          , ptr_(std::atomic_exchange(&rhs.ptr_,
+                std::shared_ptr<primitives::base_primitive>()))
+        {
+        }
+
+        primitive& operator=(primitive const& rhs)
+        {
+            if (this != &rhs)
+            {
+                this->base_type::operator=(rhs);
+                std::atomic_store(&ptr_, std::atomic_load(&rhs.ptr_));
+            }
+            return *this;
+        }
+        primitive& operator=(primitive && rhs)
+        {
+            if (this != &rhs)
+            {
+                std::atomic_store(&ptr_, std::atomic_exchange(&rhs.ptr_,
+                    std::shared_ptr<primitives::base_primitive>()));
+                this->base_type::operator=(std::move(rhs));
+            }
+            return *this;
+        }
+
+        /// Evaluate the primitive. Primitives living on this locality are
+        /// invoked directly (the pointer to the component is resolved only
+        /// once), all others are invoked through an action.
         hpx::future<primitive_result_type> eval() const;
 
+        /// Evaluate the primitive for the last time before a new value is
+        /// stored to it, variables hand over their value instead of sharing
+        /// it with the caller.
+        hpx::future<primitive_result_type> eval_last_use() const;
+
         hpx::future<void> store(primitive_result_type const&);
         void store(hpx::launch::sync_policy, primitive_result_type const&);
+
+    private:
+        // return the pointer to the component if it is local, nullptr
+        // otherwise
+        std::shared_ptr<primitives::base_primitive> local_ptr() const;
+
+        mutable std::shared_ptr<primitives::base_primitive> ptr_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -109,6 +176,9 @@ namespace phylanx { namespace execution_tree
           , std::int64_t
           , std::string
           , phylanx::ir::node_data<double>
+          , phylanx::ir::node_data<float>
+          , phylanx::ir::node_data<std::int64_t>
+          , phylanx::ir::node_data<std::uint8_t>
           , primitive
         >;
 
@@ -138,7 +208,8 @@ namespace phylanx { namespace execution_tree
         primitive_result_type && val);
 
     // Extract a ir::node_data<double> type from a given primitive_argument_type,
-    // throw if it doesn't hold one.
+    // throw if it doesn't hold one. Numeric values of other element types are
+    // promoted to double, permuted arrays are made contiguous.
     PHYLANX_EXPORT ir::node_data<double> extract_numeric_value(
         primitive_argument_type const& val);
     PHYLANX_EXPORT ir::node_data<double> extract_numeric_value(
@@ -174,6 +245,13 @@ namespace phylanx { namespace execution_tree
     PHYLANX_EXPORT hpx::future<std::uint8_t>
         boolean_operand(primitive_argument_type const& val);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // The values of variables are modified through store() only. Every store
+    // on this locality increments the store generation, values computed from
+    // variables are known to be unchanged as long as it doesn't change.
+    PHYLANX_EXPORT std::uint64_t get_store_generation();
+    PHYLANX_EXPORT void increment_store_generation();
+
     ///////////////////////////////////////////////////////////////////////////
     // Symbol table
     struct variables
@@ -214,6 +292,13 @@ namespace phylanx { namespace execution_tree
             return std::make_pair(it, variables_.end());
         }
 
+        // return whether the given variable is defined by this table itself
+        // (as opposed to an enclosing one)
+        bool defines(std::string const& name) const
+        {
+            return variables_.find(name) != variables_.end();
+        }
+
         std::pair<iterator, bool> insert(value_type const& val)
         {
             return variables_.insert(val);
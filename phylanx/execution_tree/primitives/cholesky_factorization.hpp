@@ -0,0 +1,40 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_CHOLESKY_FACTORIZATION_HPP)
+#define PHYLANX_PRIMITIVES_CHOLESKY_FACTORIZATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Compute the lower triangular matrix L of the Cholesky decomposition
+    /// A = L * transpose(L) of a symmetric positive definite matrix A.
+    class HPX_COMPONENT_EXPORT cholesky_factorization
+      : public base_primitive
+      , public hpx::components::component_base<cholesky_factorization>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        cholesky_factorization() = default;
+
+        cholesky_factorization(
+            std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+    };
+}}}
+
+#endif
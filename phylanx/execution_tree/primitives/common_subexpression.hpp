@@ -0,0 +1,48 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_COMMON_SUBEXPRESSION_HPP)
+#define PHYLANX_PRIMITIVES_COMMON_SUBEXPRESSION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Wraps a pure subexpression which is used in more than one place of an
+    /// expression (generate_tree shares one instance between all of them).
+    /// The value of the subexpression is computed once and reused until any
+    /// variable is modified (see get_store_generation()).
+    class HPX_COMPONENT_EXPORT common_subexpression
+      : public base_primitive
+      , public hpx::components::component_base<common_subexpression>
+    {
+    private:
+        using mutex_type = hpx::lcos::local::spinlock;
+
+    public:
+        common_subexpression() = default;
+
+        common_subexpression(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+
+        mutable mutex_type mtx_;
+        mutable hpx::shared_future<primitive_result_type> value_;
+        mutable std::uint64_t generation_;
+    };
+}}}
+
+#endif
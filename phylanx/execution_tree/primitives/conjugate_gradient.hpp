@@ -0,0 +1,43 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_CONJUGATE_GRADIENT_HPP)
+#define PHYLANX_PRIMITIVES_CONJUGATE_GRADIENT_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Solve the symmetric positive definite linear system A * x = b using
+    /// the conjugate gradient method:
+    /// cg(A, b, tolerance, max_iterations, x0), all arguments following b
+    /// are optional (see detail::iterative_solve). A may be a dense or a
+    /// sparse matrix, products and dot products of large operands are
+    /// computed concurrently.
+    class HPX_COMPONENT_EXPORT conjugate_gradient
+      : public base_primitive
+      , public hpx::components::component_base<conjugate_gradient>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        conjugate_gradient() = default;
+
+        conjugate_gradient(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+    };
+}}}
+
+#endif
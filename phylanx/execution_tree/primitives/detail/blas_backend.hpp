@@ -0,0 +1,53 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_BLAS_BACKEND_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_BLAS_BACKEND_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/matrix_product.hpp>
+
+#include <vector>
+
+// Operations requiring fewer floating point operations are computed by Eigen
+// even if Phylanx was built with PHYLANX_WITH_BLAS.
+#if !defined(PHYLANX_BLAS_THRESHOLD)
+#define PHYLANX_BLAS_THRESHOLD 262144
+#endif
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return whether an operation requiring the given number of floating
+    /// point operations is handed to the BLAS/LAPACK library. This is never
+    /// the case if Phylanx was built without PHYLANX_WITH_BLAS.
+    PHYLANX_EXPORT bool use_blas(double flops);
+
+    /// Compute the matrix-matrix or matrix-vector product of the given dense
+    /// operands using BLAS, result has to have the dimensions of the
+    /// product already. Returns false (leaving result alone) if the product
+    /// should be computed by Eigen instead. The BLAS library runs on the
+    /// calling thread only (large products are split into tiles by
+    /// matrix_product).
+    PHYLANX_EXPORT bool blas_matrix_product(const_matrix_ref const& lhs,
+        const_matrix_ref const& rhs, matrix_ref result);
+
+    /// Compute the inverse of the given quadratic matrix using LAPACK.
+    /// Returns false (leaving result alone) if the inverse should be
+    /// computed by Eigen instead, which includes singular matrices.
+    PHYLANX_EXPORT bool lapack_inverse(
+        const_matrix_ref const& op, matrix_type& result);
+
+    /// Compute the LU decomposition (with partial pivoting) of the given
+    /// quadratic matrix using LAPACK (dgetrf). The factors are stored in lu
+    /// as returned by dgetrf, row i was interchanged with row pivots[i]
+    /// (counting from zero). Returns false (leaving lu and pivots alone) if
+    /// the decomposition should be computed by Eigen instead.
+    PHYLANX_EXPORT bool lapack_lu(const_matrix_ref const& op,
+        matrix_type& lu, std::vector<int>& pivots);
+}}}}
+
+#endif
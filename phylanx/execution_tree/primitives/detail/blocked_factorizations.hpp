@@ -0,0 +1,61 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_BLOCKED_FACTORIZATIONS_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_BLOCKED_FACTORIZATIONS_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <Eigen/Dense>
+
+#include <cstddef>
+#include <vector>
+
+// The number of columns factorized by a single panel task, the trailing
+// matrix is updated in blocks of as many columns.
+#if !defined(PHYLANX_FACTORIZATION_BLOCK_SIZE)
+#define PHYLANX_FACTORIZATION_BLOCK_SIZE 128
+#endif
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    using matrix_type = ir::node_data<double>::storage_type;
+
+    /// Overwrite the m x n matrix a with its LU decomposition P * a = L * U
+    /// (L below the diagonal, its unit diagonal is not stored, U on and above
+    /// the diagonal). Row i was interchanged with row pivots[i] while
+    /// factorizing column i.
+    ///
+    /// The matrix is factorized in panels of PHYLANX_FACTORIZATION_BLOCK_SIZE
+    /// columns (right-looking). Each panel and each update of a block of
+    /// columns of the trailing matrix is a separate task which depends only
+    /// on the tasks producing its input, so that the next panel is factorized
+    /// while the rest of the trailing matrix is still being updated.
+    PHYLANX_EXPORT void blocked_lu(
+        matrix_type& a, std::vector<std::ptrdiff_t>& pivots);
+
+    /// Return the m x m permutation matrix P for the given row interchanges
+    /// as computed by blocked_lu.
+    PHYLANX_EXPORT matrix_type lu_permutation(
+        std::vector<std::ptrdiff_t> const& pivots, std::ptrdiff_t rows);
+
+    /// Overwrite the m x n matrix a with its QR decomposition a = Q * R using
+    /// Householder reflections (R on and above the diagonal, the essential
+    /// parts of the Householder vectors below it) and store the scaling
+    /// factors of the reflections in tau. The panels and the updates of the
+    /// trailing matrix are scheduled as for blocked_lu, the reflections of a
+    /// panel are applied at once as a block reflector.
+    PHYLANX_EXPORT void blocked_qr(matrix_type& a, std::vector<double>& tau);
+
+    /// Return the m x min(m, n) matrix Q with orthonormal columns from the
+    /// Householder reflections computed by blocked_qr.
+    PHYLANX_EXPORT matrix_type qr_thin_q(
+        matrix_type const& a, std::vector<double> const& tau);
+}}}}
+
+#endif
@@ -0,0 +1,36 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_COMBINE_ELEMENTS_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_COMBINE_ELEMENTS_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum class elementwise_operation
+    {
+        add,
+        sub,
+        div
+    };
+
+    /// Combine the corresponding elements of all operands from left to right,
+    /// e.g. compute ops[0] - ops[1] - ... - ops[n - 1] for sub. All operands
+    /// have to be dense and have the same number of elements. The result is
+    /// computed in a single pass over its elements, in place of the first
+    /// operand. Sums and differences of very many operands combine the
+    /// operands following the first in a pairwise reduction on separate
+    /// tasks.
+    PHYLANX_EXPORT ir::node_data<double> combine_elements(
+        elementwise_operation op, std::vector<ir::node_data<double>>&& ops);
+}}}}
+
+#endif
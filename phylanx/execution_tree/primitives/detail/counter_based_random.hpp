@@ -0,0 +1,51 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_COUNTER_BASED_RANDOM_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_COUNTER_BASED_RANDOM_HPP
+
+#include <phylanx/config.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    using philox_counter = std::array<std::uint32_t, 4>;
+    using philox_key = std::array<std::uint32_t, 2>;
+
+    /// The Philox4x32-10 counter-based generator (Salmon et al., "Parallel
+    /// random numbers: as easy as 1, 2, 3", SC'11): returns 128 random bits
+    /// for each distinct pair of counter and key. As the result for any
+    /// counter can be computed directly, every part of a large array can be
+    /// filled independently of all others.
+    PHYLANX_EXPORT philox_counter philox4x32(
+        philox_counter counter, philox_key key);
+
+    ///////////////////////////////////////////////////////////////////////////
+    enum class random_distribution
+    {
+        uniform,        // uniformly distributed in [-1, 1)
+        normal,         // standard normal distribution
+        bernoulli       // 1 with the given probability, 0 otherwise
+    };
+
+    /// Fill data[0, size) with random numbers drawn from the given
+    /// distribution. Element i depends on seed, stream, and i only, large
+    /// arrays are filled concurrently in chunks and the result does not
+    /// depend on the number of worker threads.
+    PHYLANX_EXPORT void fill_random(double* data, std::ptrdiff_t size,
+        random_distribution distribution, std::uint64_t seed,
+        std::uint64_t stream, double probability = 0.5);
+
+    /// Return a new stream number for each call, this is used by random
+    /// arrays which were not given an explicit stream.
+    PHYLANX_EXPORT std::uint64_t next_random_stream();
+}}}}
+
+#endif
@@ -0,0 +1,90 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_FACTORIZATION_CACHE_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_FACTORIZATION_CACHE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <Eigen/Dense>
+
+#include <memory>
+
+// The number of factorized matrices kept on each locality, the least
+// recently used one is dropped first.
+#if !defined(PHYLANX_FACTORIZATION_CACHE_SIZE)
+#define PHYLANX_FACTORIZATION_CACHE_SIZE 16
+#endif
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The LU decomposition P * A = L * U (with partial pivoting) of a
+    /// quadratic matrix A. Large matrices are factorized by LAPACK if
+    /// available (see lapack_lu), all others by Eigen::PartialPivLU, whose
+    /// interface this mirrors.
+    class lu_type
+    {
+    public:
+        using matrix_type = ir::node_data<double>::storage_type;
+        using permutation_type =
+            Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int>;
+
+        PHYLANX_EXPORT explicit lu_type(
+            Eigen::Ref<matrix_type const> const& matrix);
+
+        /// L (below the diagonal, its unit diagonal is not stored) and U
+        matrix_type const& matrixLU() const
+        {
+            return lu_;
+        }
+        permutation_type const& permutationP() const
+        {
+            return permutation_;
+        }
+
+        PHYLANX_EXPORT double determinant() const;
+
+        /// Return whether the ratio of the smallest to the largest pivot
+        /// (an estimate of the reciprocal condition number of A) is below
+        /// the machine epsilon. Solving a system for a singular matrix
+        /// yields meaningless values.
+        PHYLANX_EXPORT bool is_singular() const;
+
+        PHYLANX_EXPORT matrix_type solve(
+            Eigen::Ref<matrix_type const> const& rhs) const;
+
+    private:
+        matrix_type lu_;
+        permutation_type permutation_;
+    };
+
+    using cholesky_type = Eigen::LLT<ir::node_data<double>::storage_type>;
+
+    /// Return the LU decomposition (with partial pivoting) of the quadratic
+    /// matrix value, which was computed by the primitive given by operand.
+    /// The decomposition is reused as long as the primitive keeps producing
+    /// the same array (e.g. until a new value is stored to a variable).
+    PHYLANX_EXPORT std::shared_ptr<lu_type const> cached_lu(
+        primitive_argument_type const& operand,
+        ir::node_data<double> const& value);
+
+    /// Return the Cholesky decomposition of the symmetric positive definite
+    /// matrix value, which was computed by the primitive given by operand.
+    /// Throws if the matrix is not positive definite.
+    PHYLANX_EXPORT std::shared_ptr<cholesky_type const> cached_cholesky(
+        primitive_argument_type const& operand,
+        ir::node_data<double> const& value);
+
+    /// Drop the decompositions of the value of the given variable, this is
+    /// called whenever a new value is stored to it.
+    PHYLANX_EXPORT void invalidate_factorizations(
+        primitive_argument_type const& operand);
+}}}}
+
+#endif
@@ -0,0 +1,77 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_ITERATIVE_SOLVERS_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_ITERATIVE_SOLVERS_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <cstddef>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    using vector_type = Eigen::VectorXd;
+
+    /// The (dense or sparse) matrix of a linear system. Products of large
+    /// matrices with vectors are computed in blocks of rows on separate
+    /// tasks.
+    class PHYLANX_EXPORT linear_operator
+    {
+    public:
+        explicit linear_operator(ir::node_data<double> const& matrix);
+
+        std::ptrdiff_t rows() const;
+        std::ptrdiff_t cols() const;
+
+        /// Compute y = A * x.
+        void apply(vector_type const& x, vector_type& y) const;
+
+    private:
+        ir::node_data<double> dense_;
+        Eigen::SparseMatrix<double, Eigen::RowMajor> sparse_;
+        bool is_sparse_;
+    };
+
+    /// The termination criteria of the iterative solvers: the residual r of
+    /// the approximation x is small enough if |r| <= tolerance * |b|.
+    struct iteration_control
+    {
+        double tolerance;
+        std::ptrdiff_t max_iterations;
+    };
+
+    /// Solve the symmetric positive definite system A * x = b using the
+    /// conjugate gradient method, starting from the given approximation.
+    PHYLANX_EXPORT vector_type conjugate_gradient(linear_operator const& a,
+        vector_type const& b, vector_type x, iteration_control const& control);
+
+    /// Solve the system A * x = b using the biconjugate gradient stabilized
+    /// method, starting from the given approximation.
+    PHYLANX_EXPORT vector_type bicgstab(linear_operator const& a,
+        vector_type const& b, vector_type x, iteration_control const& control);
+
+    ///////////////////////////////////////////////////////////////////////////
+    enum class iterative_method
+    {
+        cg,
+        bicgstab
+    };
+
+    /// Solve A * x = b given the evaluated operands A, b, and optionally the
+    /// tolerance (default 1e-10), the maximal number of iterations (default
+    /// twice the size of the system), and the initial approximation of x
+    /// (default all zeros). A may be dense or sparse.
+    PHYLANX_EXPORT ir::node_data<double> iterative_solve(
+        iterative_method method, std::vector<ir::node_data<double>>&& ops);
+}}}}
+
+#endif
@@ -0,0 +1,46 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_MATRIX_PRODUCT_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_MATRIX_PRODUCT_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <Eigen/Dense>
+
+// The default extent of the tiles of the result of large matrix products
+// (each tile is computed by a separate task), the configuration setting
+// phylanx.dot.tile_size overrides it.
+#if !defined(PHYLANX_DOT_TILE_SIZE)
+#define PHYLANX_DOT_TILE_SIZE 256
+#endif
+
+// Products requiring fewer multiplications are computed by the calling
+// thread only, the configuration setting phylanx.dot.parallel_threshold
+// overrides this default.
+#if !defined(PHYLANX_DOT_PARALLEL_THRESHOLD)
+#define PHYLANX_DOT_PARALLEL_THRESHOLD 1048576
+#endif
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    using matrix_type = ir::node_data<double>::storage_type;
+    using const_matrix_ref = Eigen::Ref<matrix_type const>;
+    using matrix_ref = Eigen::Ref<matrix_type>;
+
+    /// Return the matrix-matrix or matrix-vector product of the given dense
+    /// operands, throws if the number of columns of lhs is not equal to the
+    /// number of rows of rhs. The result of a large product is split into
+    /// tiles of phylanx.dot.tile_size rows and columns which are computed
+    /// concurrently, each of them by the BLAS library if available (see
+    /// blas_backend.hpp).
+    PHYLANX_EXPORT matrix_type matrix_product(
+        const_matrix_ref const& lhs, const_matrix_ref const& rhs);
+}}}}
+
+#endif
@@ -0,0 +1,91 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_PARALLEL_ELEMENTWISE_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_PARALLEL_ELEMENTWISE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Arrays with fewer elements are processed by the calling thread only.
+    constexpr std::ptrdiff_t parallel_elementwise_threshold = 65536;
+
+    /// Number of elements processed by a single task.
+    constexpr std::ptrdiff_t parallel_elementwise_chunk_size = 32768;
+
+    using array_segment = Eigen::Map<Eigen::ArrayXd>;
+    using const_array_segment = Eigen::Map<Eigen::ArrayXd const>;
+
+    /// Invoke f(first, count) for consecutive chunks of the elements
+    /// [0, size), the chunks of large arrays are processed concurrently.
+    template <typename F>
+    void for_each_chunk(std::ptrdiff_t size, F && f)
+    {
+        if (size < parallel_elementwise_threshold)
+        {
+            f(std::ptrdiff_t(0), size);
+            return;
+        }
+
+        std::ptrdiff_t const chunks =
+            (size + parallel_elementwise_chunk_size - 1) /
+            parallel_elementwise_chunk_size;
+
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::ptrdiff_t(0), chunks,
+            [&](std::ptrdiff_t chunk)
+            {
+                std::ptrdiff_t const first =
+                    chunk * parallel_elementwise_chunk_size;
+                f(first,
+                    (std::min)(parallel_elementwise_chunk_size, size - first));
+            });
+    }
+
+    /// Replace the elements of the given operand with f(elements), f is
+    /// invoked with array segments and returns an array expression.
+    template <typename F>
+    void transform(ir::node_data<double>& op, F && f)
+    {
+        double* data = op.data();
+        for_each_chunk(std::ptrdiff_t(op.size()),
+            [&](std::ptrdiff_t first, std::ptrdiff_t count)
+            {
+                array_segment segment(data + first, count);
+                segment = f(segment);
+            });
+    }
+
+    /// Replace the elements of lhs with f(lhs elements, rhs elements), both
+    /// operands have to have the same number of elements.
+    template <typename F>
+    void transform(ir::node_data<double>& lhs,
+        ir::node_data<double> const& rhs, F && f)
+    {
+        // the data of rhs is acquired before lhs makes its data unique
+        double const* rhs_data = rhs.data();
+        double* lhs_data = lhs.data();
+        for_each_chunk(std::ptrdiff_t(lhs.size()),
+            [&](std::ptrdiff_t first, std::ptrdiff_t count)
+            {
+                array_segment segment(lhs_data + first, count);
+                segment =
+                    f(segment, const_array_segment(rhs_data + first, count));
+            });
+    }
+}}}}
+
+#endif
@@ -0,0 +1,64 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DETAIL_TYPED_ELEMENTWISE_HPP)
+#define PHYLANX_PRIMITIVES_DETAIL_TYPED_ELEMENTWISE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum class typed_operation
+    {
+        add,
+        sub,
+        mul,
+        div,
+        less,
+        less_equal,
+        greater,
+        greater_equal,
+        equal,
+        not_equal
+    };
+
+    /// Return whether the given operands of an arithmetic operation have to
+    /// be combined by typed_elementwise, i.e. whether all of them are arrays
+    /// and combining their element types (see ir::promoted_type) does not
+    /// yield double. A 0-dimensional double operand combined with a float
+    /// array is treated as a float. Boolean masks are combined as int64,
+    /// integral operands of div are always combined as double (true
+    /// division). mul is element-wise only if one
+    /// of its two operands is 0-dimensional.
+    PHYLANX_EXPORT bool is_typed_operation(typed_operation op,
+        std::vector<primitive_result_type> const& ops);
+
+    /// Combine the operands of an arithmetic operation from left to right,
+    /// computing in the promoted element type of each pair of operands.
+    /// 0-dimensional operands are combined with each element of the other
+    /// operand, all other operands have to have the same shape.
+    PHYLANX_EXPORT primitive_result_type typed_elementwise(typed_operation op,
+        std::vector<primitive_result_type>&& ops, char const* name);
+
+    /// Compare the corresponding elements of two arrays of any element type
+    /// in their promoted element type. Comparing two 0-dimensional values
+    /// returns a bool, comparing two arrays of the same shape returns a mask
+    /// (ir::node_data<std::uint8_t>) of that shape.
+    PHYLANX_EXPORT primitive_result_type compare_elements(typed_operation op,
+        primitive_result_type&& lhs, primitive_result_type&& rhs,
+        char const* name);
+
+    /// Convert all operands to double (see extract_numeric_value).
+    PHYLANX_EXPORT std::vector<ir::node_data<double>> numeric_values(
+        std::vector<primitive_result_type>&& ops);
+}}}}
+
+#endif
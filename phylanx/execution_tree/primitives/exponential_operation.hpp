@@ -21,13 +21,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         : public base_primitive
         , public hpx::components::component_base<exponential_operation>
     {
-    private:
+    public:
         using operand_type = ir::node_data<double>;
         using operands_type = std::vector<operand_type>;
 
-        std::vector<primitive_argument_type> operands_;
-
-    public:
         static std::vector<match_pattern_type> const match_data;
 
         exponential_operation() = default;
@@ -37,10 +34,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         hpx::future<primitive_result_type> eval() const override;
 
+        // apply the operation to already evaluated operands
+        static primitive_result_type apply(operands_type && ops);
+
     protected:
-        ir::node_data<double> exponential0d(operands_type && ops) const;
-        ir::node_data<double> exponential1d(operands_type && ops) const;
-        ir::node_data<double> exponentialxd(operands_type && ops) const;
+        static ir::node_data<double> exponential0d(operands_type && ops);
+        static ir::node_data<double> exponential1d(operands_type && ops);
+        static ir::node_data<double> exponentialxd(operands_type && ops);
+        static ir::node_data<double> exponentialnd(operands_type && ops);
+
+    private:
+        std::vector<primitive_argument_type> operands_;
     };
 }}}
 
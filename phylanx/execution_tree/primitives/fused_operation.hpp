@@ -0,0 +1,120 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_FUSED_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_FUSED_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A single step of the program executed by a fused_operation. The
+    /// arguments of a 'load' refer to the operands of the fused_operation,
+    /// the arguments of all other instructions refer to the values computed
+    /// by preceding instructions.
+    struct fused_instruction
+    {
+        enum class opcode : std::int8_t
+        {
+            load = 0,
+            add = 1,
+            sub = 2,
+            mul = 3,
+            div = 4,
+            negate = 5,
+            exp = 6
+        };
+
+        fused_instruction()
+          : op(opcode::load)
+        {
+        }
+
+        fused_instruction(opcode o, std::vector<std::size_t> && a)
+          : op(o)
+          , args(std::move(a))
+        {
+        }
+
+        opcode op;
+        std::vector<std::size_t> args;
+
+    private:
+        friend class hpx::serialization::access;
+
+        PHYLANX_EXPORT void serialize(
+            hpx::serialization::input_archive& ar, unsigned);
+        PHYLANX_EXPORT void serialize(
+            hpx::serialization::output_archive& ar, unsigned);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Evaluates a whole tree of element-wise operations (+, -, *, /, unary
+    /// minus, and exp) in one go. generate_tree creates this primitive in
+    /// place of a tree of the corresponding primitives. The operands are
+    /// evaluated concurrently, the program is then applied to blocks of
+    /// elements which fit into the cache, avoiding to materialize any of the
+    /// intermediate arrays. Operands for which the replaced operations would
+    /// not have been element-wise (for instance matrix products) are handled
+    /// by applying the original operations one by one. If the shapes of all
+    /// values are known when the primitive is created, evaluating it merely
+    /// verifies the shapes of the operands.
+    class HPX_COMPONENT_EXPORT fused_operation
+      : public base_primitive
+      , public hpx::components::component_base<fused_operation>
+    {
+    public:
+        using operand_type = ir::node_data<double>;
+        using operands_type = std::vector<operand_type>;
+        using shape_type = operand_type::shape_type;
+
+        fused_operation() = default;
+
+        fused_operation(std::vector<primitive_argument_type>&& operands,
+            std::vector<fused_instruction>&& program);
+
+        // the shapes give the (element-wise) shape of the value computed by
+        // each instruction of the program
+        fused_operation(std::vector<primitive_argument_type>&& operands,
+            std::vector<fused_instruction>&& program,
+            std::vector<shape_type>&& shapes);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+        // apply the given program to already evaluated operands
+        static primitive_result_type apply(operands_type && ops,
+            std::vector<fused_instruction> const& program);
+
+        // apply the given program to already evaluated operands, which are
+        // expected to have the given shapes
+        static primitive_result_type apply(operands_type && ops,
+            std::vector<fused_instruction> const& program,
+            std::vector<shape_type> const& shapes);
+
+        // Determine the shape of the value computed by the given instruction
+        // from the shapes of the values it refers to. Returns false if the
+        // original operation would not be element-wise for the given shapes.
+        static bool elementwise_shape(fused_instruction const& inst,
+            std::vector<shape_type> const& shapes, shape_type& result);
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+        std::vector<fused_instruction> program_;
+        std::vector<shape_type> shapes_;
+    };
+}}}
+
+#endif
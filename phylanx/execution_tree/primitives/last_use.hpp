@@ -0,0 +1,40 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_LAST_USE_HPP)
+#define PHYLANX_PRIMITIVES_LAST_USE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Refers to a variable whose current value is used for the last time,
+    /// as in 'store(w, w - alpha * g)' (generate_tree creates those).
+    /// Evaluating it hands over the value of the variable, which allows the
+    /// consuming operation to compute its result in the storage of the old
+    /// value. The old value is gone even if computing the new value fails:
+    /// the variable is left without a value until the next store.
+    class HPX_COMPONENT_EXPORT last_use
+      : public base_primitive
+      , public hpx::components::component_base<last_use>
+    {
+    public:
+        last_use() = default;
+
+        last_use(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,50 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_LOOP_INVARIANT_HPP)
+#define PHYLANX_PRIMITIVES_LOOP_INVARIANT_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Wraps a subexpression of a loop which doesn't depend on any of the
+    /// variables modified by the loop (generate_tree creates those). The
+    /// subexpression is evaluated on first use only, its value is reused
+    /// until the primitive is reset by storing any value to it. Loops reset
+    /// their invariants whenever they start iterating.
+    class HPX_COMPONENT_EXPORT loop_invariant
+      : public base_primitive
+      , public hpx::components::component_base<loop_invariant>
+    {
+    private:
+        using mutex_type = hpx::lcos::local::spinlock;
+
+    public:
+        loop_invariant() = default;
+
+        loop_invariant(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+        // discard the memoized value
+        void store(primitive_result_type const&) override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+
+        mutable mutex_type mtx_;
+        mutable hpx::shared_future<primitive_result_type> value_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,46 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_LU_DECOMPOSE_HPP)
+#define PHYLANX_PRIMITIVES_LU_DECOMPOSE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Compute the LU decomposition P * A = L * U of a m x n matrix A using
+    /// a blocked algorithm whose panels and trailing updates run as separate
+    /// tasks (see detail/blocked_factorizations.hpp). lu_decompose(A) returns
+    /// L (below the diagonal, its diagonal is all ones) and U (on and above
+    /// the diagonal) in a single matrix, lu_decompose(A, part) returns the
+    /// factor selected by part, which is one of "L" (m x min(m, n)), "U"
+    /// (min(m, n) x n), or "P" (m x m).
+    class HPX_COMPONENT_EXPORT lu_decompose
+      : public base_primitive
+      , public hpx::components::component_base<lu_decompose>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        lu_decompose() = default;
+
+        lu_decompose(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+        std::string part_;
+    };
+}}}
+
+#endif
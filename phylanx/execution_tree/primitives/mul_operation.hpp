@@ -24,11 +24,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : public base_primitive
       , public hpx::components::component_base<mul_operation>
     {
-    private:
+    public:
         using operand_type = ir::node_data<double>;
         using operands_type = std::vector<operand_type>;
 
-    public:
         static std::vector<match_pattern_type> const match_data;
 
         mul_operation() = default;
@@ -37,9 +36,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         hpx::future<primitive_result_type> eval() const override;
 
+        // apply the operation to already evaluated operands
+        static primitive_result_type apply(operands_type && ops);
+
     protected:
-        ir::node_data<double> mul0d(operands_type && ops) const;
-        ir::node_data<double> mulxd(operands_type && ops) const;
+        static ir::node_data<double> mul0d(operands_type && ops);
+        static ir::node_data<double> mulxd(operands_type && ops);
 
     private:
         std::vector<primitive_argument_type> operands_;
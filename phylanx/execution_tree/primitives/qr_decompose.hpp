@@ -0,0 +1,45 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_QR_DECOMPOSE_HPP)
+#define PHYLANX_PRIMITIVES_QR_DECOMPOSE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Compute the QR decomposition A = Q * R of a m x n matrix A using
+    /// blocked Householder reflections whose panels and trailing updates run
+    /// as separate tasks (see detail/blocked_factorizations.hpp).
+    /// qr_decompose(A) returns the upper triangular factor R (min(m, n) x n),
+    /// qr_decompose(A, part) returns the factor selected by part, which is
+    /// either "Q" (m x min(m, n), with orthonormal columns) or "R".
+    class HPX_COMPONENT_EXPORT qr_decompose
+      : public base_primitive
+      , public hpx::components::component_base<qr_decompose>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        qr_decompose() = default;
+
+        qr_decompose(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+        std::string part_;
+    };
+}}}
+
+#endif
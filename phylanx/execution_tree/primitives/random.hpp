@@ -13,10 +13,18 @@
 
 #include <hpx/include/components.hpp>
 
+#include <string>
 #include <vector>
 
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    /// random(A[, distribution[, seed[, stream[, probability]]]]) returns
+    /// an array of the shape of A filled with random numbers drawn from the
+    /// given distribution: "uniform" in [-1, 1) (the default), "normal"
+    /// (standard normal), or "bernoulli" (1 with the given probability,
+    /// which defaults to 0.5, 0 otherwise). The numbers are generated by a
+    /// counter-based generator (see detail/counter_based_random.hpp), the
+    /// same seed and stream always produce the same array.
     class HPX_COMPONENT_EXPORT random
       : public base_primitive
       , public hpx::components::component_base<random>
@@ -32,6 +40,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     private:
         std::vector<primitive_argument_type> operands_;
+        std::string distribution_;
     };
 }}}
 
@@ -0,0 +1,46 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_SOLVE_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_SOLVE_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Solve the linear system A * x = b for x, where b is a vector or a
+    /// matrix of right hand sides: solve(A, b) or solve(A, b, method). The
+    /// method is either "lu" (the default) or "cholesky" (requires A to be
+    /// symmetric positive definite). The decomposition of A is reused as long
+    /// as the value of A doesn't change (see detail::cached_lu). The method
+    /// "inverse" computes dot(inverse(A), b), which is rewritten to it: A is
+    /// decomposed as for "lu" unless it is singular.
+    class HPX_COMPONENT_EXPORT solve_operation
+      : public base_primitive
+      , public hpx::components::component_base<solve_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        solve_operation() = default;
+
+        solve_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval() const override;
+
+    private:
+        std::vector<primitive_argument_type> operands_;
+        std::string method_;
+    };
+}}}
+
+#endif
@@ -32,6 +32,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         hpx::future<primitive_result_type> eval() const override;
 
+        // apply the operation to already evaluated operands
+        static primitive_result_type apply(
+            std::vector<ir::node_data<double>>&& ops);
+
     private:
         std::vector<primitive_argument_type> operands_;
     };
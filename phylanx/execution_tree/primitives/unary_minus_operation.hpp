@@ -36,6 +36,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         hpx::future<primitive_result_type> eval() const override;
 
+        // apply the operation to already evaluated operands
+        static primitive_result_type apply(
+            std::vector<ir::node_data<double>>&& ops);
+
     protected:
         ir::node_data<double> neg0d(operands_type && ops) const;
         ir::node_data<double> negxd(operands_type && ops) const;
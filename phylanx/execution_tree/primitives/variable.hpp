@@ -38,6 +38,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         hpx::future<primitive_result_type> eval() const override;
         void store(primitive_result_type const& data) override;
 
+        // hand over the value, the variable is empty until the next store
+        // (even if the store fails as computing the new value throws)
+        hpx::future<primitive_result_type> eval_last_use() override;
+
     private:
         primitive_result_type data_;
         std::string name_;
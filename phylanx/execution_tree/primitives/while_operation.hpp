@@ -32,10 +32,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         while_operation(std::vector<primitive_argument_type>&& operands);
 
+        // the given loop invariants (see loop_invariant) are reset whenever
+        // the loop starts iterating
+        while_operation(std::vector<primitive_argument_type>&& operands,
+            std::vector<primitive_argument_type>&& invariants);
+
         hpx::future<primitive_result_type> eval() const override;
 
     private:
         std::vector<primitive_argument_type> operands_;
+        std::vector<primitive_argument_type> invariants_;
     };
 }}}
 
@@ -0,0 +1,36 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_SHAPE_INFERENCE_HPP)
+#define PHYLANX_EXECUTION_TREE_SHAPE_INFERENCE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The shape of a value as far as it is known before evaluating the
+    /// expression producing it (0-dimensional values have an empty shape).
+    using static_shape = util::optional<ir::node_data<double>::shape_type>;
+
+    /// Return the shape of the given value, the shape of primitives is
+    /// not known.
+    PHYLANX_EXPORT static_shape shape_of(primitive_argument_type const& value);
+
+    /// Return the shape of the value the primitive registered under the given
+    /// name would compute from operands of the given shapes. The result is
+    /// empty if it can't be determined without evaluating the operands.
+    /// Throws if the given shapes are known to be rejected by the primitive.
+    PHYLANX_EXPORT static_shape infer_shape(std::string const& name,
+        std::vector<static_shape> const& operands);
+}}
+
+#endif
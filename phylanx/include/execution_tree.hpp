@@ -8,6 +8,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/generate_tree.hpp>
+#include <phylanx/execution_tree/shape_inference.hpp>
 #include <phylanx/include/primitives.hpp>
 
 #endif
@@ -7,20 +7,31 @@
 #define PHYLANX_IR_NODE_DATA_AUG_26_2017_0924AM
 
 #include <phylanx/config.hpp>
+#include <phylanx/ir/node_data_pool.hpp>
 #include <phylanx/util/serialization/eigen.hpp>
 
+#include <hpx/exception.hpp>
 #include <hpx/include/serialization.hpp>
 #include <hpx/include/util.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/lcos/local/once.hpp>
+#include <hpx/util/atomic_count.hpp>
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 #include <boost/intrusive_ptr.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace phylanx { namespace ir
@@ -92,97 +103,485 @@ namespace phylanx { namespace ir
             T const* p_;
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        // Return a new number identifying an array (see node_data::identity).
+        PHYLANX_EXPORT std::uint64_t next_array_identity();
+
+        ///////////////////////////////////////////////////////////////////////
+        // Reference counted holder for the data referred to by a node_data
+        // instance. The data is shared between all copies of a node_data and
+        // is copied only if one of the instances is about to be modified.
+        //
+        // The holder either owns its data (data_), refers to externally
+        // managed memory (external_, rows_, cols_) which is never modified, or
+        // holds a sparse matrix (sparse_data_). Dense access to sparse data
+        // is served from a copy which is created on first use. Holders owning
+        // dense data are recycled through a node_data_pool once released.
+        template <typename T>
+        struct node_data_storage
+        {
+            using storage_type =
+                Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+            using sparse_storage_type = Eigen::SparseMatrix<T>;
+
+            node_data_storage()
+              : count_(0)
+              , identity_(next_array_identity())
+              , external_(nullptr)
+              , rows_(0)
+              , cols_(0)
+              , is_sparse_(false)
+            {
+            }
+
+            explicit node_data_storage(storage_type const& data)
+              : count_(0)
+              , identity_(next_array_identity())
+              , data_(data)
+              , external_(nullptr)
+              , rows_(0)
+              , cols_(0)
+              , is_sparse_(false)
+            {
+            }
+            explicit node_data_storage(storage_type && data)
+              : count_(0)
+              , identity_(next_array_identity())
+              , data_(std::move(data))
+              , external_(nullptr)
+              , rows_(0)
+              , cols_(0)
+              , is_sparse_(false)
+            {
+            }
+
+            node_data_storage(T const* data, std::ptrdiff_t rows,
+                    std::ptrdiff_t cols, std::shared_ptr<void> keep_alive)
+              : count_(0)
+              , identity_(next_array_identity())
+              , external_(data)
+              , rows_(rows)
+              , cols_(cols)
+              , keep_alive_(std::move(keep_alive))
+              , is_sparse_(false)
+            {
+            }
+
+            explicit node_data_storage(sparse_storage_type const& data)
+              : count_(0)
+              , identity_(next_array_identity())
+              , external_(nullptr)
+              , rows_(0)
+              , cols_(0)
+              , sparse_data_(data)
+              , is_sparse_(true)
+            {
+            }
+            explicit node_data_storage(sparse_storage_type && data)
+              : count_(0)
+              , identity_(next_array_identity())
+              , external_(nullptr)
+              , rows_(0)
+              , cols_(0)
+              , sparse_data_(std::move(data))
+              , is_sparse_(true)
+            {
+            }
+
+            node_data_storage(node_data_storage const&) = delete;
+            node_data_storage& operator=(node_data_storage const&) = delete;
+
+            bool is_view() const
+            {
+                return external_ != nullptr;
+            }
+            bool is_sparse() const
+            {
+                return is_sparse_;
+            }
+
+            T const* data() const
+            {
+                if (is_sparse_)
+                {
+                    return dense_data().data();
+                }
+                return is_view() ? external_ : data_.data();
+            }
+            std::ptrdiff_t rows() const
+            {
+                if (is_sparse_)
+                {
+                    return sparse_data_.rows();
+                }
+                return is_view() ? rows_ : data_.rows();
+            }
+            std::ptrdiff_t cols() const
+            {
+                if (is_sparse_)
+                {
+                    return sparse_data_.cols();
+                }
+                return is_view() ? cols_ : data_.cols();
+            }
+
+            storage_type const& dense_data() const
+            {
+                hpx::lcos::local::call_once(dense_flag_,
+                    [this]()
+                    {
+                        dense_data_ = storage_type(sparse_data_);
+                    });
+                return dense_data_;
+            }
+
+            hpx::util::atomic_count count_;
+            std::uint64_t identity_;
+            storage_type data_;
+
+            T const* external_;
+            std::ptrdiff_t rows_;
+            std::ptrdiff_t cols_;
+            std::shared_ptr<void> keep_alive_;
+
+            sparse_storage_type sparse_data_;
+            bool is_sparse_;
+            mutable hpx::lcos::local::once_flag dense_flag_;
+            mutable storage_type dense_data_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Shape and strides (in elements) of a N-dimensional array referring
+        // to the data held by a node_data_storage. Axis 0 is the fastest
+        // varying one (column-major, as for Eigen matrices). The layout is
+        // valid only as long as the holder has the dimensions it was created
+        // for (rows_, cols_). Access to the elements of a permuted array
+        // through the const accessors of node_data is served from a
+        // contiguous copy which is created on first use.
+        template <typename T>
+        struct tensor_layout
+        {
+            using shape_type = std::vector<std::ptrdiff_t>;
+            using storage_type =
+                Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+            tensor_layout(shape_type const& shape, shape_type const& strides,
+                    std::ptrdiff_t rows, std::ptrdiff_t cols)
+              : shape_(shape)
+              , strides_(strides)
+              , rows_(rows)
+              , cols_(cols)
+              , contiguous_(strides == column_major_strides(shape))
+            {
+            }
+
+            static shape_type column_major_strides(shape_type const& shape)
+            {
+                shape_type strides(shape.size());
+                std::ptrdiff_t stride = 1;
+                for (std::size_t i = 0; i != shape.size(); ++i)
+                {
+                    strides[i] = stride;
+                    stride *= shape[i];
+                }
+                return strides;
+            }
+
+            static std::ptrdiff_t num_elements(shape_type const& shape)
+            {
+                std::ptrdiff_t result = 1;
+                for (std::ptrdiff_t extent : shape)
+                {
+                    result *= extent;
+                }
+                return result;
+            }
+
+            shape_type shape_;
+            shape_type strides_;
+            std::ptrdiff_t rows_;
+            std::ptrdiff_t cols_;
+            bool contiguous_;
+            mutable hpx::lcos::local::once_flag contiguous_flag_;
+            mutable storage_type contiguous_data_;
+        };
+
+        template <typename T>
+        void intrusive_ptr_add_ref(node_data_storage<T>* p)
+        {
+            ++p->count_;
+        }
+
+        template <typename T>
+        void intrusive_ptr_release(node_data_storage<T>* p)
+        {
+            if (0 == --p->count_)
+            {
+                // a recycled holder will hold a different array
+                p->identity_ = next_array_identity();
+                if (p->is_view() || p->is_sparse() ||
+                    !node_data_pool<node_data_storage<T>>::release(p))
+                {
+                    delete p;
+                }
+            }
+        }
+
         /// \endcond
     }
 
     ///////////////////////////////////////////////////////////////////////////
+    // Supported element types are double, float, std::int64_t and
+    // std::uint8_t (used for boolean values/masks).
+    template <typename T>
+    class node_data;
+
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename T>
+        struct element_type_rank;
+
+        template <>
+        struct element_type_rank<std::uint8_t>
+          : std::integral_constant<int, 0>
+        {
+        };
+        template <>
+        struct element_type_rank<std::int64_t>
+          : std::integral_constant<int, 1>
+        {
+        };
+        template <>
+        struct element_type_rank<float>
+          : std::integral_constant<int, 2>
+        {
+        };
+        template <>
+        struct element_type_rank<double>
+          : std::integral_constant<int, 3>
+        {
+        };
+        /// \endcond
+    }
+
+    /// Element type resulting from combining node_data<T> and node_data<U>:
+    /// bool < int64 < float < double, except that combining int64 and float
+    /// yields double (float can't represent all int64 values).
+    template <typename T, typename U>
+    struct promoted_type
+    {
+        using type = typename std::conditional<
+                detail::element_type_rank<T>::value >=
+                    detail::element_type_rank<U>::value,
+                T, U
+            >::type;
+    };
+
+    template <>
+    struct promoted_type<std::int64_t, float>
+    {
+        using type = double;
+    };
+    template <>
+    struct promoted_type<float, std::int64_t>
+    {
+        using type = double;
+    };
+
+    template <typename T, typename U>
+    using promoted_type_t = typename promoted_type<T, U>::type;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // node_data represents N-dimensional arrays. Arrays with up to two
+    // dimensions are directly represented by an Eigen matrix, arrays with more
+    // dimensions (and reshaped or permuted arrays) additionally carry their
+    // shape and strides. Those are exposed to the matrix based interfaces
+    // (matrix(), dimensions()) as a 2-dimensional array with the extent of
+    // the first axis as the number of rows, i.e. collapsing all other axes.
     template <typename T>
     class node_data
     {
+    private:
+        using holder_type = detail::node_data_storage<T>;
+        using layout_type = detail::tensor_layout<T>;
+
     public:
         constexpr static std::size_t const max_dimensions = 2;
 
         using dimensions_type = std::array<std::ptrdiff_t, max_dimensions>;
+        using shape_type = std::vector<std::ptrdiff_t>;
         using storage_type = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
         using constant_type = Eigen::DenseBase<storage_type>;
+        using const_view_type = Eigen::Map<storage_type const>;
+        using sparse_storage_type = Eigen::SparseMatrix<T>;
 
         using storage1d_type = Eigen::Matrix<T, Eigen::Dynamic, 1>;
 
-        node_data() = default;
+        node_data()
+          : value_()
+          , is_scalar_(false)
+        {
+        }
 
+        /// Create node data with the given dimensions, the elements are not
+        /// initialized.
         node_data(dimensions_type const& dims)
+          : value_()
+          , is_scalar_(false)
         {
-            if (dims[1] != 1)
-            {
-                data_ = constant_type::Constant(dims[0], dims[1]);
-            }
-            else if (dims[0] != 1)
+            if (dims[0] != 1 || dims[1] != 1)
             {
-                data_ = constant_type::Constant(dims[0], 1);
+                data_.reset(allocate(dims[0], dims[1]));
             }
             else
             {
-                data_ = constant_type::Constant(1, 1);
+                is_scalar_ = true;
             }
         }
 
         node_data(dimensions_type const& dims, T default_value)
+          : value_()
+          , is_scalar_(false)
         {
-            if (dims[1] != 1)
-            {
-                data_ = constant_type::Constant(dims[0], dims[1], default_value);
-            }
-            else if (dims[0] != 1)
+            if (dims[0] != 1 || dims[1] != 1)
             {
-                data_ = constant_type::Constant(dims[0], 1, default_value);
+                data_.reset(allocate(dims[0], dims[1]));
+                data_->data_.setConstant(default_value);
             }
             else
             {
-                data_ = constant_type::Constant(1, 1, default_value);
+                value_ = default_value;
+                is_scalar_ = true;
             }
         }
 
-        /// Create node data for a 0-dimensional value
+        /// Create node data for a 0-dimensional value. The value is stored
+        /// inline, no memory is allocated.
         node_data(T const& value)
-          : data_(constant_type::Constant(1, 1, value))
+          : value_(value)
+          , is_scalar_(true)
         {
         }
         node_data(T && value)
-          : data_(constant_type::Constant(1, 1, std::move(value)))
+          : value_(std::move(value))
+          , is_scalar_(true)
         {
         }
 
         /// Create node data for a 1-dimensional value
         node_data(storage1d_type const& values)
-          : data_(values)
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(values))
         {
         }
         node_data(storage1d_type && values)
-          : data_(std::move(values))
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(storage_type(std::move(values))))
         {
         }
         node_data(std::vector<T> const& values)
-          : data_(Eigen::Map<storage1d_type const, Eigen::Unaligned>(
-                values.data(), values.size()))
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(
+                Eigen::Map<storage1d_type const, Eigen::Unaligned>(
+                    values.data(), values.size())))
         {
         }
 
         /// Create node data for a 2-dimensional value
         node_data(storage_type const& values)
-          : data_(values)
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(values))
         {
         }
         node_data(storage_type && values)
-          : data_(std::move(values))
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(std::move(values)))
+        {
+        }
+
+        /// Create node data for a sparse 2-dimensional value (stored in
+        /// compressed sparse column format).
+        node_data(sparse_storage_type const& values)
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(values))
+        {
+        }
+        node_data(sparse_storage_type && values)
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(std::move(values)))
         {
         }
 
+        /// Create node data referring to externally managed memory holding
+        /// the elements of a (column-major) array with the given dimensions.
+        ///
+        /// The data is not copied. The caller is responsible for keeping the
+        /// referenced memory alive and unchanged for as long as any node_data
+        /// instance (including copies of this one) refers to it. Alternatively,
+        /// a keep_alive handle can be supplied which will be released only
+        /// after the last node_data instance referring to the memory has gone
+        /// away. The referenced memory is never modified, any mutating access
+        /// makes a private copy of the data first.
+        node_data(T const* data, dimensions_type const& dims,
+                std::shared_ptr<void> keep_alive = std::shared_ptr<void>())
+          : value_()
+          , is_scalar_(false)
+          , data_(new holder_type(data, dims[0], dims[1], std::move(keep_alive)))
+        {
+        }
+
+        /// Create node data by converting the elements of node data of a
+        /// different element type.
+        template <typename U, typename Enable = typename std::enable_if<
+            !std::is_same<T, U>::value>::type>
+        explicit node_data(node_data<U> const& d)
+          : value_()
+          , is_scalar_(d.is_scalar())
+        {
+            if (is_scalar_)
+            {
+                value_ = static_cast<T>(d[0]);
+            }
+            else if (d.is_sparse())
+            {
+                data_.reset(new holder_type(sparse_storage_type(
+                    d.sparse_matrix().template cast<T>())));
+            }
+            else if (d.size() != 0)
+            {
+                node_data<U> const c = d.contiguous();
+                data_.reset(new holder_type(
+                    storage_type(c.matrix().template cast<T>())));
+                if (c.num_dimensions() > max_dimensions)
+                {
+                    *this = reshape(c.shape());
+                }
+            }
+        }
+
+        /// Copying a node_data instance does not copy the underlying data,
+        /// both instances will refer to the same data until one of them is
+        /// modified.
         node_data(node_data const& d)
-          : data_(d.data_)
+          : value_(d.value_)
+          , is_scalar_(d.is_scalar_)
+          , data_(d.data_)
+          , layout_(d.layout_)
         {
         }
         node_data(node_data && d)
-          : data_(std::move(d.data_))
+          : value_(std::move(d.value_))
+          , is_scalar_(d.is_scalar_)
+          , data_(std::move(d.data_))
+          , layout_(std::move(d.layout_))
         {
         }
 
@@ -190,7 +589,10 @@ namespace phylanx { namespace ir
         {
             if (this != &d)
             {
+                value_ = d.value_;
+                is_scalar_ = d.is_scalar_;
                 data_ = d.data_;
+                layout_ = d.layout_;
             }
             return *this;
         }
@@ -198,29 +600,53 @@ namespace phylanx { namespace ir
         {
             if (this != &d)
             {
+                value_ = std::move(d.value_);
+                is_scalar_ = d.is_scalar_;
                 data_ = std::move(d.data_);
+                layout_ = std::move(d.layout_);
             }
             return *this;
         }
 
-
         /// Access a specific element of the underlying N-dimensional array
         T& operator[](std::ptrdiff_t index)
         {
-            return data_.data()[index];
+            return data()[index];
         }
         T& operator[](dimensions_type const& indicies)
         {
-            return data_(indicies[0], indicies[1]);
+            return data()[indicies[0] + indicies[1] * matrix_rows()];
         }
 
         T const& operator[](std::ptrdiff_t index) const
         {
-            return data_.data()[index];
+            return data()[index];
         }
         T const& operator[](dimensions_type const& indicies) const
         {
-            return data_(indicies[0], indicies[1]);
+            return data()[indicies[0] + indicies[1] * matrix_rows()];
+        }
+
+        /// Access a specific element using one index per dimension, this
+        /// respects the strides of permuted arrays.
+        T const& at(shape_type const& indicies) const
+        {
+            layout_type const* l = layout();
+            if (l == nullptr)
+            {
+                HPX_ASSERT(indicies.size() <= max_dimensions);
+                std::ptrdiff_t row = indicies.empty() ? 0 : indicies[0];
+                std::ptrdiff_t col = indicies.size() < 2 ? 0 : indicies[1];
+                return data()[row + col * matrix_rows()];
+            }
+
+            HPX_ASSERT(indicies.size() == l->shape_.size());
+            std::ptrdiff_t offset = 0;
+            for (std::size_t i = 0; i != indicies.size(); ++i)
+            {
+                offset += indicies[i] * l->strides_[i];
+            }
+            return data_->data()[offset];
         }
 
         using iterator = detail::node_value_iterator<T>;
@@ -229,12 +655,12 @@ namespace phylanx { namespace ir
         /// Get iterator referring to the beginning of the underlying data
         iterator begin() const
         {
-            return iterator{data_.data()};
+            return iterator{data()};
         }
         /// Get iterator referring to the end of the underlying data
         iterator end() const
         {
-            return iterator{data_.data() + data_.size()};
+            return iterator{data() + size()};
         }
 
         iterator cbegin() const
@@ -249,48 +675,311 @@ namespace phylanx { namespace ir
 
         T* data()
         {
-            return data_.data();
+            if (is_scalar_)
+            {
+                return &value_;
+            }
+            return mutable_storage().data();
         }
+        /// Access the underlying data, stored contiguously in column-major
+        /// order. The const overload refers to a contiguous copy of the
+        /// elements of permuted arrays, which is created on first use and
+        /// kept for as long as the permuted array exists.
         T const* data() const
         {
-            return data_.data();
+            if (is_scalar_)
+            {
+                return &value_;
+            }
+            layout_type const* l = layout();
+            if (l != nullptr && !l->contiguous_)
+            {
+                hpx::lcos::local::call_once(l->contiguous_flag_,
+                    [this, l]()
+                    {
+                        l->contiguous_data_.resize(
+                            matrix_rows(), matrix_cols());
+                        copy_contiguous(*l, l->contiguous_data_.data());
+                    });
+                return l->contiguous_data_.data();
+            }
+            return data_ ? data_->data() : nullptr;
         }
         std::size_t size() const
         {
-            return data_.size();
+            if (is_scalar_)
+            {
+                return 1;
+            }
+            return data_ ? data_->rows() * data_->cols() : 0;
         }
 
+        /// Access the underlying data. The non-const overload makes sure the
+        /// data is owned by this instance and is not shared with any other
+        /// node_data instance (which may require copying it). For
+        /// 0-dimensional values it moves the inline value to the heap. The
+        /// const overload never copies the data (except for permuted arrays,
+        /// see data()).
         storage_type& matrix()
         {
-            return data_;
+            return mutable_storage();
+        }
+        const_view_type matrix() const
+        {
+            return const_view_type(data(), matrix_rows(), matrix_cols());
+        }
+
+        /// Return whether the underlying data is shared with other node_data
+        /// instances, i.e. whether modifying it would require a copy.
+        bool is_shared() const
+        {
+            return data_ && data_->count_ != 1;
+        }
+
+        /// Return a number identifying the array this instance refers to. It
+        /// is shared by all copies of the array, but never used for any
+        /// other array (even if that reuses the same memory). The identity
+        /// of an array doesn't change if it is modified in place. Returns 0
+        /// for 0-dimensional values held inline.
+        std::uint64_t identity() const
+        {
+            return data_ ? data_->identity_ : 0;
+        }
+
+        /// Return whether this instance refers to externally managed memory.
+        bool is_view() const
+        {
+            return data_ && data_->is_view();
+        }
+
+        /// Return whether this instance holds sparse data. Sparse data can
+        /// be accessed directly through sparse_matrix(). All other accessors
+        /// expose it as a dense array: the const accessors refer to a dense
+        /// copy created on first use, the non-const accessors convert the
+        /// data to a dense array.
+        bool is_sparse() const
+        {
+            return data_ && data_->is_sparse();
+        }
+
+        /// Access the underlying sparse data, requires is_sparse() to be
+        /// true. The non-const overload makes sure the data is not shared
+        /// with any other node_data instance (which may require copying it).
+        sparse_storage_type const& sparse_matrix() const
+        {
+            HPX_ASSERT(is_sparse());
+            return data_->sparse_data_;
         }
-        storage_type const& matrix() const
+        sparse_storage_type& sparse_matrix()
         {
-            return data_;
+            HPX_ASSERT(is_sparse());
+
+            // always create a new holder to discard a dense copy of the data
+            // which might have been created already
+            layout_.reset();
+            if (data_->count_ != 1)
+            {
+                data_.reset(new holder_type(data_->sparse_data_));
+            }
+            else
+            {
+                data_.reset(new holder_type(std::move(data_->sparse_data_)));
+            }
+            return data_->sparse_data_;
+        }
+
+        /// Return whether this instance holds a 0-dimensional value inline.
+        bool is_scalar() const
+        {
+            return is_scalar_;
+        }
+
+        /// Return whether the elements are stored contiguously in
+        /// column-major order (this is false for permuted arrays only).
+        bool is_contiguous() const
+        {
+            layout_type const* l = layout();
+            return l == nullptr || l->contiguous_;
         }
 
         /// Extract the dimensionality of the underlying data array.
         std::size_t num_dimensions() const
         {
-            if (data_.cols() != 1)
+            layout_type const* l = layout();
+            if (l != nullptr && l->shape_.size() > max_dimensions)
+            {
+                return l->shape_.size();
+            }
+            if (dimension(1) != 1)
             {
                 return 2;
             }
-            if (data_.rows() != 1)
+            if (dimension(0) != 1)
             {
                 return 1;
             }
             return 0;
         }
 
-        /// Extract the dimensional extends of the underlying data array.
+        /// Extract the dimensional extends of the underlying data array. For
+        /// arrays with more than two dimensions this returns the extends of
+        /// the 2-dimensional view used by matrix().
         dimensions_type dimensions() const
         {
-            return dimensions_type{data_.rows(), data_.cols()};
+            return dimensions_type{matrix_rows(), matrix_cols()};
         }
         std::size_t dimension(std::size_t dim) const
         {
-            return (dim == 0) ? data_.rows() : data_.cols();
+            if (is_scalar_)
+            {
+                return 1;
+            }
+            if (!data_)
+            {
+                return 0;
+            }
+            layout_type const* l = layout();
+            if (l != nullptr)
+            {
+                return dim < l->shape_.size() ? l->shape_[dim] : 1;
+            }
+            return (dim == 0) ? data_->rows() : data_->cols();
+        }
+
+        /// Extract the extends of all dimensions of the underlying data array
+        shape_type shape() const
+        {
+            layout_type const* l = layout();
+            if (l != nullptr && l->shape_.size() > max_dimensions)
+            {
+                return l->shape_;
+            }
+
+            std::size_t dims = num_dimensions();
+            shape_type result(dims);
+            for (std::size_t i = 0; i != dims; ++i)
+            {
+                result[i] = dimension(i);
+            }
+            return result;
+        }
+
+        /// Extract the strides (in elements) of all dimensions
+        shape_type strides() const
+        {
+            layout_type const* l = layout();
+            if (l != nullptr && l->shape_.size() > max_dimensions)
+            {
+                return l->strides_;
+            }
+            if (l != nullptr && !l->contiguous_)
+            {
+                return shape_type(l->strides_.begin(),
+                    l->strides_.begin() + num_dimensions());
+            }
+            return layout_type::column_major_strides(shape());
+        }
+
+        /// Return a node_data instance referring to the same data, but with a
+        /// different shape. This does not copy the data (unless the array is
+        /// not contiguous).
+        node_data reshape(shape_type const& shape) const
+        {
+            if (layout_type::num_elements(shape) != std::ptrdiff_t(size()))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::ir::node_data<T>::reshape",
+                    "the new shape must have the same number of elements "
+                        "as the array being reshaped");
+            }
+
+            if (!is_contiguous())
+            {
+                return contiguous().reshape(shape);
+            }
+
+            node_data result(*this);
+            if (result.is_scalar_)
+            {
+                result.data_.reset(new holder_type(
+                    constant_type::Constant(1, 1, value_)));
+                result.is_scalar_ = false;
+            }
+            result.layout_ = std::make_shared<layout_type const>(shape,
+                layout_type::column_major_strides(shape),
+                result.data_->rows(), result.data_->cols());
+            return result;
+        }
+
+        /// Return a node_data instance referring to the same data, but with
+        /// its axes reordered: axis i of the result is axis axes[i] of this
+        /// array. This does not copy the data.
+        node_data permute(std::vector<std::size_t> const& axes) const
+        {
+            shape_type const old_shape = shape();
+            shape_type const old_strides = strides();
+
+            if (axes.size() != old_shape.size())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::ir::node_data<T>::permute",
+                    "the number of axes must match the number of dimensions "
+                        "of the array being permuted");
+            }
+
+            std::vector<bool> seen(axes.size(), false);
+            shape_type shape(axes.size()), strides(axes.size());
+            for (std::size_t i = 0; i != axes.size(); ++i)
+            {
+                if (axes[i] >= axes.size() || seen[axes[i]])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::ir::node_data<T>::permute",
+                        "invalid axes, the axes must be a permutation of " +
+                            std::to_string(axes.size()) + " dimensions");
+                }
+                seen[axes[i]] = true;
+                shape[i] = old_shape[axes[i]];
+                strides[i] = old_strides[axes[i]];
+            }
+
+            if (axes.size() < 2)
+            {
+                return *this;
+            }
+
+            node_data result(*this);
+            result.layout_ = std::make_shared<layout_type const>(
+                shape, strides, data_->rows(), data_->cols());
+            return result;
+        }
+
+        /// Return a node_data instance holding the same elements stored
+        /// contiguously in column-major order. This copies the data only if
+        /// this array is not contiguous.
+        node_data contiguous() const
+        {
+            layout_type const* l = layout();
+            if (l == nullptr || l->contiguous_)
+            {
+                return *this;
+            }
+
+            shape_type const& shape = l->shape_;
+
+            boost::intrusive_ptr<holder_type> result(
+                allocate(matrix_rows(), matrix_cols()));
+            copy_contiguous(*l, result->data_.data());
+
+            node_data nd;
+            nd.data_ = std::move(result);
+            if (shape.size() > max_dimensions)
+            {
+                nd.layout_ = std::make_shared<layout_type const>(shape,
+                    layout_type::column_major_strides(shape),
+                    nd.data_->rows(), nd.data_->cols());
+            }
+            return nd;
         }
 
         explicit operator bool() const;
@@ -301,15 +990,257 @@ namespace phylanx { namespace ir
 
     private:
         /// \cond NOINTERNAL
+        // create a holder owning an uninitialized buffer, possibly reusing
+        // a buffer of the same size released earlier by this thread
+        static holder_type* allocate(std::ptrdiff_t rows, std::ptrdiff_t cols)
+        {
+            return detail::node_data_pool<holder_type>::acquire(rows, cols);
+        }
+
+        // copy the elements described by the given layout to dest, stored
+        // contiguously in column-major order
+        void copy_contiguous(layout_type const& l, T* dest) const
+        {
+            shape_type const& shape = l.shape_;
+            shape_type const& strides = l.strides_;
+
+            std::ptrdiff_t const inner_size = shape[0];
+            std::ptrdiff_t const inner_stride = strides[0];
+            std::ptrdiff_t const outer_size =
+                layout_type::num_elements(shape) / inner_size;
+
+            T const* src = data_->data();
+
+            // copy along the first (fastest varying) axis of the result in the
+            // innermost loop, iterating over all other axes like an odometer
+            shape_type index(shape.size(), 0);
+            for (std::ptrdiff_t outer = 0; outer != outer_size; ++outer)
+            {
+                std::ptrdiff_t offset = 0;
+                for (std::size_t i = 1; i != shape.size(); ++i)
+                {
+                    offset += index[i] * strides[i];
+                }
+
+                T const* s = src + offset;
+                for (std::ptrdiff_t inner = 0; inner != inner_size; ++inner)
+                {
+                    *dest++ = s[inner * inner_stride];
+                }
+
+                for (std::size_t i = 1; i != shape.size(); ++i)
+                {
+                    if (++index[i] != shape[i])
+                    {
+                        break;
+                    }
+                    index[i] = 0;
+                }
+            }
+        }
+
+        // return the layout if it still applies to the held data
+        layout_type const* layout() const
+        {
+            if (!layout_ || !data_ || data_->rows() != layout_->rows_ ||
+                data_->cols() != layout_->cols_)
+            {
+                return nullptr;
+            }
+            return layout_.get();
+        }
+
+        // extends of the 2-dimensional view of the data
+        std::ptrdiff_t matrix_rows() const
+        {
+            layout_type const* l = layout();
+            if (l != nullptr)
+            {
+                return l->shape_.empty() ? 1 : l->shape_[0];
+            }
+            return dimension(0);
+        }
+        std::ptrdiff_t matrix_cols() const
+        {
+            layout_type const* l = layout();
+            if (l != nullptr)
+            {
+                return l->shape_.empty() ?
+                    1 : layout_type::num_elements(l->shape_) / l->shape_[0];
+            }
+            return dimension(1);
+        }
+
+        // copy-on-write: detach from shared (or external) data before
+        // handing out mutable access
+        storage_type& mutable_storage()
+        {
+            if (layout_ && layout() == nullptr)
+            {
+                layout_.reset();        // the layout does not apply anymore
+            }
+
+            if (layout_ && !layout_->contiguous_)
+            {
+                *this = contiguous();
+            }
+
+            if (is_scalar_)
+            {
+                data_.reset(allocate(1, 1));
+                data_->data_(0, 0) = std::move(value_);
+                is_scalar_ = false;
+            }
+            else if (!data_)
+            {
+                data_.reset(new holder_type());
+            }
+            else if (data_->is_sparse())
+            {
+                data_.reset(new holder_type(storage_type(data_->sparse_data_)));
+            }
+            else if (data_->count_ != 1 || data_->is_view())
+            {
+                boost::intrusive_ptr<holder_type> p(
+                    allocate(data_->rows(), data_->cols()));
+                p->data_ = const_view_type(
+                    data_->data(), data_->rows(), data_->cols());
+                data_ = std::move(p);
+            }
+
+            // make the held matrix match the 2-dimensional view of the data,
+            // this does not touch the elements as the size doesn't change
+            if (layout_)
+            {
+                std::ptrdiff_t rows = matrix_rows();
+                std::ptrdiff_t cols = matrix_cols();
+                if (layout_->shape_.size() <= max_dimensions)
+                {
+                    layout_.reset();
+                }
+                else if (rows != data_->data_.rows())
+                {
+                    layout_ = std::make_shared<layout_type const>(
+                        layout_->shape_, layout_->strides_, rows, cols);
+                }
+                data_->data_.resize(rows, cols);
+            }
+            return data_->data_;
+        }
+
         friend class hpx::serialization::access;
 
+        // Archives written before the format version was introduced consist
+        // of the data in the format used for Eigen matrices only, they start
+        // with the (non-negative) number of rows.
         template <typename Archive>
-        void serialize(Archive& ar, unsigned)
+        void load(Archive& ar, unsigned)
         {
-            ar & data_;
+            std::ptrdiff_t tag = 0;
+            ar >> tag;
+
+            layout_.reset();
+            if (tag >= 0)
+            {
+                std::ptrdiff_t cols = 0;
+                ar >> cols;
+
+                storage_type data(tag, cols);
+                ar >> hpx::serialization::make_array(data.data(), tag * cols);
+                load_dense(std::move(data), shape_type());
+                return;
+            }
+
+            if (-tag > serialization_format_version)
+            {
+                HPX_THROW_EXCEPTION(hpx::serialization_error,
+                    "node_data::load",
+                    "the archive was written using an unknown format "
+                        "version of node_data");
+            }
+
+            bool sparse = false;
+            ar >> sparse;
+
+            if (sparse)
+            {
+                sparse_storage_type data;
+                ar >> data;
+                is_scalar_ = false;
+                data_.reset(new holder_type(std::move(data)));
+                return;
+            }
+
+            storage_type data;
+            shape_type shape;
+            ar >> data >> shape;
+            load_dense(std::move(data), std::move(shape));
+        }
+
+        void load_dense(storage_type&& data, shape_type&& shape)
+        {
+            if (data.rows() == 1 && data.cols() == 1 && shape.empty())
+            {
+                value_ = data(0, 0);
+                is_scalar_ = true;
+                data_.reset();
+            }
+            else
+            {
+                is_scalar_ = false;
+                data_.reset(new holder_type(std::move(data)));
+                if (!shape.empty())
+                {
+                    layout_ = std::make_shared<layout_type const>(shape,
+                        layout_type::column_major_strides(shape),
+                        data_->rows(), data_->cols());
+                }
+            }
         }
 
-        storage_type data_;
+        // the negated format version written in front of the data
+        static constexpr std::ptrdiff_t serialization_format_version = 1;
+
+        // the negated format version and a flag for sparse data, followed by
+        // the data using the same format as for Eigen matrices (see eigen.hpp)
+        // and the shape of arrays with more than two dimensions
+        template <typename Archive>
+        void save(Archive& ar, unsigned) const
+        {
+            std::ptrdiff_t const tag = -serialization_format_version;
+            bool sparse = is_sparse() && layout() == nullptr;
+            ar << tag << sparse;
+            if (sparse)
+            {
+                ar << data_->sparse_data_;
+                return;
+            }
+
+            node_data const nd = contiguous();
+
+            std::ptrdiff_t rows = nd.matrix_rows();
+            std::ptrdiff_t cols = nd.matrix_cols();
+            ar << rows << cols
+               << hpx::serialization::make_array(nd.data(), rows * cols);
+
+            shape_type shape;
+            if (nd.num_dimensions() > max_dimensions)
+            {
+                shape = nd.shape();
+            }
+            ar << shape;
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER()
+
+        // 0-dimensional values are stored inline (if is_scalar_ is set)
+        T value_;
+        bool is_scalar_;
+
+        boost::intrusive_ptr<holder_type> data_;
+
+        // shape and strides of reshaped, permuted or N-dimensional arrays
+        std::shared_ptr<layout_type const> layout_;
         /// \endcond
     };
 
@@ -318,13 +1249,15 @@ namespace phylanx { namespace ir
     bool operator==(node_data<T> const& lhs, node_data<T> const& rhs)
     {
         if (lhs.num_dimensions() != rhs.num_dimensions() ||
-            lhs.dimensions() != rhs.dimensions())
+            lhs.shape() != rhs.shape())
         {
             return false;
         }
 
-        return std::equal(hpx::util::begin(lhs), hpx::util::end(lhs),
-            hpx::util::begin(rhs), hpx::util::end(rhs));
+        node_data<T> const l = lhs.contiguous();
+        node_data<T> const r = rhs.contiguous();
+        return std::equal(hpx::util::begin(l), hpx::util::end(l),
+            hpx::util::begin(r), hpx::util::end(r));
     }
 
     template <typename T>
@@ -335,6 +1268,12 @@ namespace phylanx { namespace ir
 
     PHYLANX_EXPORT std::ostream& operator<<(
         std::ostream& out, node_data<double> const& nd);
+    PHYLANX_EXPORT std::ostream& operator<<(
+        std::ostream& out, node_data<float> const& nd);
+    PHYLANX_EXPORT std::ostream& operator<<(
+        std::ostream& out, node_data<std::int64_t> const& nd);
+    PHYLANX_EXPORT std::ostream& operator<<(
+        std::ostream& out, node_data<std::uint8_t> const& nd);
 }}
 
 #endif
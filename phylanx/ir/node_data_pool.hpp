@@ -0,0 +1,166 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_IR_NODE_DATA_POOL_HPP)
+#define PHYLANX_IR_NODE_DATA_POOL_HPP
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace phylanx { namespace ir
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Statistics of the pools recycling the buffers of node_data instances.
+    struct node_data_pool_statistics
+    {
+        std::uint64_t hits;         // allocations served from a pool
+        std::uint64_t misses;       // allocations requiring a new buffer
+    };
+
+    /// Return the accumulated statistics of all node_data buffer pools,
+    /// optionally resetting the counters.
+    PHYLANX_EXPORT node_data_pool_statistics get_node_data_pool_statistics(
+        bool reset = false);
+
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        PHYLANX_EXPORT void count_node_data_pool_access(bool hit);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Per-thread pool of released (dense, owned) node_data_storage
+        // instances, keyed by their number of elements. Reusing a holder
+        // reuses its Eigen buffer (allocated with Eigen's default alignment),
+        // loops evaluating expressions of the same shapes over and over
+        // don't go through malloc this way.
+        template <typename Holder>
+        class node_data_pool
+        {
+        private:
+            using value_type = typename Holder::storage_type::Scalar;
+
+            // limits for the buffers cached by a single thread
+            static constexpr std::size_t max_cached_per_size = 8;
+            static constexpr std::size_t max_cached_bytes = 32 * 1024 * 1024;
+
+        public:
+            node_data_pool()
+              : cached_bytes_(0)
+            {
+            }
+
+            node_data_pool(node_data_pool const&) = delete;
+            node_data_pool& operator=(node_data_pool const&) = delete;
+
+            ~node_data_pool()
+            {
+                destroyed_ = true;
+                for (auto& free_list : free_lists_)
+                {
+                    for (Holder* p : free_list.second)
+                    {
+                        delete p;
+                    }
+                }
+            }
+
+            // return a holder owning a buffer of the given dimensions, the
+            // elements are not initialized
+            static Holder* acquire(std::ptrdiff_t rows, std::ptrdiff_t cols)
+            {
+                std::size_t const size = std::size_t(rows * cols);
+                if (size == 0)
+                {
+                    return new Holder();
+                }
+
+                node_data_pool* pool = instance();
+                if (pool != nullptr)
+                {
+                    auto it = pool->free_lists_.find(size);
+                    if (it != pool->free_lists_.end() && !it->second.empty())
+                    {
+                        Holder* p = it->second.back();
+                        it->second.pop_back();
+                        pool->cached_bytes_ -= size * sizeof(value_type);
+
+                        count_node_data_pool_access(true);
+
+                        // this does not reallocate as the size is unchanged
+                        p->data_.resize(rows, cols);
+                        return p;
+                    }
+                }
+
+                count_node_data_pool_access(false);
+
+                Holder* p = new Holder();
+                p->data_.resize(rows, cols);
+                return p;
+            }
+
+            // try to keep the given (unreferenced) holder for later reuse,
+            // returns false if the holder has to be deleted by the caller
+            static bool release(Holder* p)
+            {
+                std::size_t const size = p->data_.size();
+                if (size == 0)
+                {
+                    return false;
+                }
+
+                node_data_pool* pool = instance();
+                if (pool == nullptr)
+                {
+                    return false;
+                }
+
+                std::size_t const bytes = size * sizeof(value_type);
+                if (pool->cached_bytes_ + bytes > max_cached_bytes)
+                {
+                    return false;
+                }
+
+                std::vector<Holder*>& free_list = pool->free_lists_[size];
+                if (free_list.size() >= max_cached_per_size)
+                {
+                    return false;
+                }
+
+                free_list.push_back(p);
+                pool->cached_bytes_ += bytes;
+                return true;
+            }
+
+        private:
+            // holders may be released while thread-local objects are being
+            // destroyed, the pool must not be used anymore at that point
+            static node_data_pool* instance()
+            {
+                if (destroyed_)
+                {
+                    return nullptr;
+                }
+                static thread_local node_data_pool pool;
+                return &pool;
+            }
+
+            static thread_local bool destroyed_;
+
+            std::unordered_map<std::size_t, std::vector<Holder*>> free_lists_;
+            std::size_t cached_bytes_;
+        };
+
+        template <typename Holder>
+        thread_local bool node_data_pool<Holder>::destroyed_ = false;
+        /// \endcond
+    }
+}}
+
+#endif
@@ -13,6 +13,7 @@
 #include <cstddef>
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 namespace hpx { namespace serialization
 {
@@ -44,6 +45,50 @@ namespace hpx { namespace serialization
         (template <typename T, int Rows, int Cols, int Options,
             int MaxRows, int MaxCols>),
         (Eigen::Matrix<T, Rows, Cols, Options, MaxRows, MaxCols>));
+
+    ///////////////////////////////////////////////////////////////////////////
+    // sparse matrices are serialized in compressed format
+    template <typename T, int Options, typename StorageIndex>
+    void load(input_archive& ar,
+        Eigen::SparseMatrix<T, Options, StorageIndex>& m, unsigned)
+    {
+        std::ptrdiff_t rows = 0;
+        std::ptrdiff_t cols = 0;
+        std::ptrdiff_t nonzeros = 0;
+        ar >> rows >> cols >> nonzeros;
+
+        m = Eigen::SparseMatrix<T, Options, StorageIndex>(rows, cols);
+        m.resizeNonZeros(nonzeros);
+
+        ar >> make_array(m.outerIndexPtr(), m.outerSize() + 1)
+           >> make_array(m.innerIndexPtr(), nonzeros)
+           >> make_array(m.valuePtr(), nonzeros);
+    }
+
+    template <typename T, int Options, typename StorageIndex>
+    void save(output_archive& ar,
+        Eigen::SparseMatrix<T, Options, StorageIndex> const& m, unsigned)
+    {
+        if (!m.isCompressed())
+        {
+            Eigen::SparseMatrix<T, Options, StorageIndex> compressed(m);
+            compressed.makeCompressed();
+            save(ar, compressed, 0);
+            return;
+        }
+
+        std::ptrdiff_t rows = m.rows();
+        std::ptrdiff_t cols = m.cols();
+        std::ptrdiff_t nonzeros = m.nonZeros();
+        ar << rows << cols << nonzeros
+           << make_array(m.outerIndexPtr(), m.outerSize() + 1)
+           << make_array(m.innerIndexPtr(), nonzeros)
+           << make_array(m.valuePtr(), nonzeros);
+    }
+
+    HPX_SERIALIZATION_SPLIT_FREE_TEMPLATE(
+        (template <typename T, int Options, typename StorageIndex>),
+        (Eigen::SparseMatrix<T, Options, StorageIndex>));
 }}
 
 #endif
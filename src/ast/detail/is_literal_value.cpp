@@ -95,6 +95,15 @@ namespace phylanx { namespace ast { namespace detail
         case 2:     // std::uint64_t
             return ir::node_data<double>{double(util::get<2>(val))};
 
+        case 5:     // phylanx::ir::node_data<float>
+            return ir::node_data<double>{util::get<5>(val)};
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return ir::node_data<double>{util::get<6>(val)};
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return ir::node_data<double>{util::get<7>(val)};
+
         default:
             break;
         }
@@ -12,15 +12,23 @@
 #include <phylanx/ast/detail/is_placeholder_ellipses.hpp>
 #include <phylanx/execution_tree/generate_tree.hpp>
 #include <phylanx/execution_tree/primitives.hpp>
+#include <phylanx/execution_tree/shape_inference.hpp>
 #include <phylanx/ir/node_data.hpp>
 
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
 #include <hpx/util/tuple.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -29,108 +37,1684 @@ namespace phylanx { namespace execution_tree
     namespace detail
     {
         ///////////////////////////////////////////////////////////////////////
+        // cache of the parsed form of the pattern strings seen so far, it is
+        // emptied whenever it reaches its maximal size (pattern lists passed
+        // to generate_tree may differ for each invocation)
+        class pattern_ast_cache
+        {
+        private:
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            static constexpr std::size_t const max_size = 1024;
+
+        public:
+            ast::expression get(std::string const& pattern)
+            {
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    auto it = cache_.find(pattern);
+                    if (it != cache_.end())
+                    {
+                        return it->second;
+                    }
+                }
+
+                // parse the pattern without holding the lock
+                ast::expression expr = ast::generate_ast(pattern);
+
+                std::lock_guard<mutex_type> l(mtx_);
+                if (cache_.size() >= max_size)
+                {
+                    cache_.clear();
+                }
+                return cache_.emplace(pattern, std::move(expr)).first->second;
+            }
+
+        private:
+            mutex_type mtx_;
+            std::unordered_map<std::string, ast::expression> cache_;
+        };
+
+        pattern_ast_cache& get_pattern_ast_cache()
+        {
+            static pattern_ast_cache cache;
+            return cache;
+        }
+
         expression_pattern_list generate_patterns(
             pattern_list const& patterns_list)
         {
+            pattern_ast_cache& cache = get_pattern_ast_cache();
+
+            std::size_t size = 0;
+            for (auto const& patterns : patterns_list)
+            {
+                size += patterns.size();
+            }
+
             expression_pattern_list result;
-            result.reserve(patterns_list.size());
+            result.reserve(size);
+
+            for (auto const& patterns : patterns_list)
+            {
+                for (auto const& pattern : patterns)
+                {
+                    result.push_back(
+                        hpx::util::make_tuple(
+                            hpx::util::get<0>(pattern),
+                            hpx::util::get<1>(pattern),
+                            cache.get(hpx::util::get<1>(pattern)),
+                            hpx::util::get<2>(pattern)));
+                }
+            }
+
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct on_placeholder_match
+        {
+            std::multimap<std::string, ast::expression>& placeholders;
+
+            template <typename Ast1, typename Ast2, typename... Ts>
+            bool operator()(
+                Ast1 const& ast1, Ast2 const& ast2, Ts const&... ts) const
+            {
+                using value_type = typename std::multimap<std::string,
+                    ast::expression>::value_type;
+
+                if (ast::detail::is_placeholder(ast1))
+                {
+                    if (ast::detail::is_placeholder_ellipses(ast1))
+                    {
+                        placeholders.insert(value_type(
+                            ast::detail::identifier_name(ast1).substr(1),
+                            ast::expression(ast2)));
+                    }
+                    else
+                    {
+                        placeholders.insert(
+                            value_type(ast::detail::identifier_name(ast1),
+                                ast::expression(ast2)));
+                    }
+                }
+                else if (ast::detail::is_placeholder(ast2))
+                {
+                    if (ast::detail::is_placeholder_ellipses(ast1))
+                    {
+                        placeholders.insert(value_type(
+                            ast::detail::identifier_name(ast2).substr(1),
+                            ast::expression(ast1)));
+                    }
+                    else
+                    {
+                        placeholders.insert(
+                            value_type(ast::detail::identifier_name(ast2),
+                                ast::expression(ast1)));
+                    }
+                }
+                return true;
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Classification of the root node of an expression, two expressions
+        // can match only if their root nodes have the same key.
+        enum class root_kind
+        {
+            keyed,              // the root node is described by the key
+            keyed_call,         // the root node is a call to the named function
+            wildcard,           // matches any expression (a placeholder)
+            call_wildcard       // matches any function call
+        };
+
+        std::pair<root_kind, std::string> root_key(ast::expression const& expr)
+        {
+            if (ast::detail::is_placeholder(expr))
+            {
+                return std::make_pair(root_kind::wildcard, std::string());
+            }
+
+            ast::expression const& subexpr =
+                ast::detail::extract_expression(expr);
+
+            // binary operations are identified by their first operator
+            if (!subexpr.rest.empty())
+            {
+                return std::make_pair(root_kind::keyed,
+                    "op:" + std::to_string(
+                        static_cast<int>(subexpr.rest.front().operator_)));
+            }
+
+            ast::operand const& op = subexpr.first;
+            if (op.index() == 2)        // unary_expr
+            {
+                return std::make_pair(root_kind::keyed,
+                    "unary:" + std::to_string(static_cast<int>(
+                        util::get<2>(op.get()).get().operator_)));
+            }
+
+            if (op.index() != 1)        // nil
+            {
+                return std::make_pair(root_kind::keyed, std::string("nil"));
+            }
+
+            ast::primary_expr const& pe = util::get<1>(op.get()).get();
+            switch (pe.index())
+            {
+            case 3:     // identifier
+                {
+                    ast::identifier const& id = util::get<3>(pe.get());
+                    if (ast::detail::is_placeholder(id))
+                    {
+                        return std::make_pair(
+                            root_kind::wildcard, std::string());
+                    }
+                    return std::make_pair(root_kind::keyed, "id:" + id.name);
+                }
+
+            case 7:     // function_call
+                {
+                    ast::identifier const& name =
+                        util::get<7>(pe.get()).get().function_name;
+                    if (ast::detail::is_placeholder(name))
+                    {
+                        return std::make_pair(
+                            root_kind::call_wildcard, std::string());
+                    }
+                    return std::make_pair(
+                        root_kind::keyed_call, "call:" + name.name);
+                }
+
+            default:
+                break;
+            }
+
+            // literal values
+            return std::make_pair(root_kind::keyed, std::string("literal"));
+        }
+
+        std::vector<std::size_t> merge_indices(
+            std::vector<std::size_t> const& lhs,
+            std::vector<std::size_t> const& rhs)
+        {
+            std::vector<std::size_t> result;
+            result.reserve(lhs.size() + rhs.size());
+            std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                std::back_inserter(result));
+            return result;
+        }
+
+        indexed_pattern_list::indexed_pattern_list(
+                expression_pattern_list patterns)
+          : patterns_(std::move(patterns))
+        {
+            std::unordered_map<std::string, root_kind> kinds;
+
+            all_.reserve(patterns_.size());
+            for (std::size_t i = 0; i != patterns_.size(); ++i)
+            {
+                all_.push_back(i);
+
+                std::pair<root_kind, std::string> key =
+                    root_key(hpx::util::get<2>(patterns_[i]));
+
+                switch (key.first)
+                {
+                case root_kind::wildcard:
+                    wildcards_.push_back(i);
+                    break;
+
+                case root_kind::call_wildcard:
+                    call_wildcards_.push_back(i);
+                    break;
+
+                default:
+                    index_[key.second].push_back(i);
+                    kinds[key.second] = key.first;
+                    break;
+                }
+            }
+
+            // merge the wildcards into the specific lists, preserving the
+            // order of the patterns
+            call_wildcards_ = merge_indices(call_wildcards_, wildcards_);
+            for (auto& entry : index_)
+            {
+                entry.second = merge_indices(entry.second,
+                    kinds[entry.first] == root_kind::keyed_call ?
+                        call_wildcards_ : wildcards_);
+            }
+        }
+
+        std::vector<std::size_t> const& indexed_pattern_list::candidates(
+            ast::expression const& expr) const
+        {
+            std::pair<root_kind, std::string> key = root_key(expr);
+            switch (key.first)
+            {
+            case root_kind::keyed: HPX_FALLTHROUGH;
+            case root_kind::keyed_call:
+                {
+                    auto it = index_.find(key.second);
+                    if (it != index_.end())
+                    {
+                        return it->second;
+                    }
+                    return key.first == root_kind::keyed_call ?
+                        call_wildcards_ : wildcards_;
+                }
+
+            default:
+                break;
+            }
+
+            // placeholders in the expression itself could match anything
+            return all_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Generate the tree for the given expression. Unlike generate_tree,
+        // this returns literal values and the values of subexpressions folded
+        // at build time as they are (without wrapping them into a variable).
+        struct generation_context;
+
+        primitive_argument_type generate_expression(
+            ast::expression const& expr,
+            indexed_pattern_list const& patterns,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions,
+            generation_context& context);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Operations which have no side effects and whose result depends on
+        // the values of their arguments only. Such operations are evaluated
+        // at build time if all of their arguments are literal values.
+        bool is_pure_operation(std::string const& name)
+        {
+            static char const* const pure_operations[] =
+            {
+                "add", "and", "bicgstab", "cg", "cholesky", "constant",
+                "determinant", "div", "dot", "equal", "exp", "greater",
+                "greater_equal", "inverse", "less", "less_equal", "lu",
+                "lu_decompose", "mul", "not_equal", "or", "qr_decompose",
+                "solve", "sub", "transpose", "unary_minus", "unary_not"
+            };
+
+            for (char const* pure_operation : pure_operations)
+            {
+                if (name == pure_operation)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool all_literal_values(
+            std::vector<primitive_argument_type> const& arguments)
+        {
+            return std::none_of(arguments.begin(), arguments.end(),
+                [](primitive_argument_type const& arg)
+                {
+                    return is_primitive_operand(arg);
+                });
+        }
+
+        // Evaluate the given primitive and return its value. If this fails
+        // the primitive is kept, reporting the error when the expression is
+        // evaluated.
+        primitive_argument_type fold_constant(primitive_argument_type && p)
+        {
+            try
+            {
+                return to_primitive_value_type(
+                    primitive_operand(p).eval().get());
+            }
+            catch (hpx::exception const&)
+            {
+                return std::move(p);
+            }
+        }
+
+        class loop_invariants;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Pure subexpressions occurring more than once in an expression. All
+        // occurrences share one primitives::common_subexpression, which
+        // evaluates the subexpression only once as long as no variable is
+        // modified in between. A subexpression is pure if it consists of
+        // pure operations only and all variables it refers to refer to
+        // values (see loop_invariants::refers_to_value).
+        class common_subexpressions
+        {
+        private:
+            struct entry
+            {
+                ast::expression expr;
+                std::size_t count;
+                std::set<std::string> identifiers;
+                primitive_argument_type value;
+            };
+
+        public:
+            common_subexpressions(ast::expression const& expr,
+                    indexed_pattern_list const& patterns,
+                    loop_invariants const& invariants)
+              : invariants_(invariants)
+            {
+                std::set<std::string> identifiers;
+                count(expr, patterns, identifiers);
+            }
+
+            // return whether the given expression occurs more than once
+            bool is_common(ast::expression const& expr) const
+            {
+                entry const* e = find(expr);
+                return e != nullptr && e->count > 1 && refers_to_values(*e);
+            }
+
+            // return the primitive shared by all occurrences of the given
+            // expression, if it was created already
+            primitive_argument_type const* shared_value(
+                ast::expression const& expr) const
+            {
+                entry const* e = find(expr);
+                return (e != nullptr && valid(e->value)) ? &e->value : nullptr;
+            }
+
+            // make the given primitive shared by all occurrences of the given
+            // expression
+            primitive_argument_type share(ast::expression const& expr,
+                primitive_argument_type && value)
+            {
+                entry* e = find(expr);
+                if (e == nullptr || e->count < 2 ||
+                    !is_primitive_operand(value) || !refers_to_values(*e))
+                {
+                    return std::move(value);
+                }
+
+                e->value = hpx::new_<primitives::common_subexpression>(
+                    hpx::find_here(), std::vector<primitive_argument_type>{
+                        std::move(value)});
+                return e->value;
+            }
+
+        private:
+            entry* find(ast::expression const& expr)
+            {
+                auto it = entries_.find(ast::to_string(expr));
+                if (it != entries_.end())
+                {
+                    for (entry& e : it->second)
+                    {
+                        if (e.expr == expr)
+                        {
+                            return &e;
+                        }
+                    }
+                }
+                return nullptr;
+            }
+            entry const* find(ast::expression const& expr) const
+            {
+                return const_cast<common_subexpressions*>(this)->find(expr);
+            }
+
+            // the variables are known to refer to values only once the
+            // expressions defining them have been generated
+            bool refers_to_values(entry const& e) const;
+
+            // Count the occurrences of all pure subexpressions of the given
+            // expression, return whether the expression consists of pure
+            // operations only and collect the variables it refers to.
+            bool count(ast::expression const& expr,
+                indexed_pattern_list const& patterns,
+                std::set<std::string>& identifiers)
+            {
+                if (ast::detail::is_literal_value(expr))
+                {
+                    return true;
+                }
+
+                if (ast::detail::is_identifier(expr))
+                {
+                    identifiers.insert(ast::detail::identifier_name(expr));
+                    return true;
+                }
+
+                entry* e = find(expr);
+                if (e != nullptr)
+                {
+                    ++e->count;     // subexpressions are counted already
+                    identifiers.insert(
+                        e->identifiers.begin(), e->identifiers.end());
+                    return true;
+                }
+
+                for (std::size_t i : patterns.candidates(expr))
+                {
+                    expression_pattern const& pattern = patterns.patterns()[i];
+
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
+                            on_placeholder_match{placeholders}))
+                    {
+                        continue;
+                    }
+
+                    std::string const& name = hpx::util::get<0>(pattern);
+                    if (name == "define" && placeholders.size() > 2)
+                    {
+                        return false;   // function bodies are generated later
+                    }
+
+                    bool pure = is_pure_operation(name);
+                    std::set<std::string> nested;
+                    for (auto const& placeholder : placeholders)
+                    {
+                        if (!count(placeholder.second, patterns, nested))
+                        {
+                            pure = false;
+                        }
+                    }
+
+                    if (!pure)
+                    {
+                        return false;
+                    }
+
+                    identifiers.insert(nested.begin(), nested.end());
+                    entries_[ast::to_string(expr)].push_back(entry{
+                        expr, 1, std::move(nested), primitive_argument_type{}});
+                    return true;
+                }
+                return false;
+            }
+
+            loop_invariants const& invariants_;
+            std::unordered_map<std::string, std::vector<entry>> entries_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The names of all variables an expression could modify (including
+        // the invoked functions). If the analysis is conservative, variables
+        // passed to functions which can't be analyzed are assumed to be
+        // modified, otherwise the analysis fails for those.
+        class modified_variables
+        {
+        public:
+            modified_variables(indexed_pattern_list const& patterns,
+                    phylanx::execution_tree::functions& functions,
+                    bool conservative)
+              : patterns_(patterns)
+              , functions_(functions)
+              , conservative_(conservative)
+            {
+            }
+
+            // Return false if the modified variables can't be determined.
+            bool collect(ast::expression const& expr,
+                std::set<std::string>& modified) const
+            {
+                std::set<std::string> active;
+                return collect_modified(expr,
+                    std::map<std::string, std::string>{}, modified, active);
+            }
+
+        private:
+            // Collect the names of all variables the given expression could
+            // modify (including the invoked functions), return false if those
+            // can't be determined. The renamed map translates the formal
+            // parameters of invoked functions into the names of the variables
+            // passed as arguments.
+            bool collect_modified(ast::expression const& expr,
+                std::map<std::string, std::string> const& renamed,
+                std::set<std::string>& modified,
+                std::set<std::string>& active) const
+            {
+                auto resolve =
+                    [&](ast::expression const& var) -> std::string
+                    {
+                        std::string name = ast::detail::identifier_name(var);
+                        auto it = renamed.find(name);
+                        return it != renamed.end() ? it->second : name;
+                    };
+
+                for (std::size_t i : patterns_.candidates(expr))
+                {
+                    expression_pattern const& pattern = patterns_.patterns()[i];
+
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
+                            on_placeholder_match{placeholders}))
+                    {
+                        continue;
+                    }
+
+                    std::string const& name = hpx::util::get<0>(pattern);
+                    if ((name == "store" || name == "define") &&
+                        !placeholders.empty() &&
+                        ast::detail::is_identifier(
+                            placeholders.begin()->second))
+                    {
+                        ast::expression const& target =
+                            placeholders.begin()->second;
+                        std::string var = resolve(target);
+                        if (!var.empty())
+                        {
+                            modified.insert(std::move(var));
+                        }
+
+                        // formal parameters may be bound to values
+                        if (conservative_)
+                        {
+                            modified.insert(
+                                ast::detail::identifier_name(target));
+                        }
+                    }
+                    else if (name == "any_function" &&
+                        !collect_modified_invocation(
+                            placeholders, resolve, modified, active))
+                    {
+                        return false;
+                    }
+
+                    for (auto const& placeholder : placeholders)
+                    {
+                        if (!collect_modified(
+                                placeholder.second, renamed, modified, active))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                return true;
+            }
+
+            template <typename Resolve>
+            bool collect_modified_invocation(
+                std::multimap<std::string, ast::expression> const& placeholders,
+                Resolve const& resolve, std::set<std::string>& modified,
+                std::set<std::string>& active) const
+            {
+                if (analyze_invocation(placeholders, resolve, modified, active))
+                {
+                    return true;
+                }
+                if (!conservative_)
+                {
+                    return false;
+                }
+
+                // the function could modify all variables passed to it
+                auto args = placeholders.equal_range("__2");
+                for (/**/; args.first != args.second; ++args.first)
+                {
+                    if (ast::detail::is_identifier(args.first->second))
+                    {
+                        std::string var = resolve(args.first->second);
+                        if (!var.empty())
+                        {
+                            modified.insert(std::move(var));
+                        }
+                    }
+                }
+                return true;
+            }
+
+            template <typename Resolve>
+            bool analyze_invocation(
+                std::multimap<std::string, ast::expression> const& placeholders,
+                Resolve const& resolve, std::set<std::string>& modified,
+                std::set<std::string>& active) const
+            {
+                auto callee = placeholders.find("_1");
+                if (callee == placeholders.end() ||
+                    !ast::detail::is_identifier(callee->second))
+                {
+                    return false;
+                }
+
+                std::string name = ast::detail::identifier_name(callee->second);
+                auto f = functions_.find(name);
+                if (is_empty_range(f) || !active.insert(name).second)
+                {
+                    return false;   // unknown or recursive function
+                }
+
+                std::vector<ast::expression> const& parameters =
+                    f.first->second.first;
+                auto args = placeholders.equal_range("__2");
+                if (std::size_t(std::distance(args.first, args.second)) !=
+                    parameters.size())
+                {
+                    active.erase(name);
+                    return false;
+                }
+
+                // variables passed as arguments are modified through the
+                // formal parameters of the function
+                std::map<std::string, std::string> renamed;
+                for (ast::expression const& parameter : parameters)
+                {
+                    if (!ast::detail::is_identifier(parameter))
+                    {
+                        active.erase(name);
+                        return false;
+                    }
+                    renamed[ast::detail::identifier_name(parameter)] =
+                        ast::detail::is_identifier(args.first->second) ?
+                            resolve(args.first->second) : std::string();
+                    ++args.first;
+                }
+
+                bool const result = collect_modified(
+                    f.first->second.second, renamed, modified, active);
+
+                active.erase(name);
+                return result;
+            }
+
+            indexed_pattern_list const& patterns_;
+            phylanx::execution_tree::functions& functions_;
+            bool conservative_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Loop-invariant code motion: pure subexpressions of a loop which
+        // depend only on variables not modified by the loop are wrapped into
+        // a primitives::loop_invariant, which evaluates them at most once per
+        // execution of the loop.
+        class loop_invariants
+        {
+        private:
+            struct loop
+            {
+                bool analyzed;
+                std::set<std::string> modified;
+                std::vector<std::pair<ast::expression, primitive_argument_type>>
+                    invariants;
+            };
+
+        public:
+            loop_invariants(indexed_pattern_list const& patterns,
+                    phylanx::execution_tree::variables& variables,
+                    phylanx::execution_tree::functions& functions)
+              : patterns_(patterns)
+              , variables_(variables)
+              , functions_(functions)
+              , suspended_(false)
+            {
+            }
+
+            // The given variable refers to a value, either created
+            // implicitly or defined by a literal.
+            void define_value(std::string const& name)
+            {
+                values_.insert(name);
+            }
+
+            // The given variable refers to the given expression, which is
+            // evaluated whenever the variable is used.
+            void define_expression(
+                std::string const& name, ast::expression const& expr)
+            {
+                expressions_.emplace(name, expr);
+            }
+
+            // Start generating the given loop.
+            void enter_loop(ast::expression const& expr)
+            {
+                loop l;
+                l.analyzed = modified_variables(patterns_, functions_, false)
+                    .collect(expr, l.modified);
+                loops_.push_back(std::move(l));
+            }
+
+            // Finish generating the innermost loop, return the loop
+            // invariants the loop has to reset.
+            std::vector<primitive_argument_type> leave_loop()
+            {
+                std::vector<primitive_argument_type> result;
+                result.reserve(loops_.back().invariants.size());
+                for (auto& invariant : loops_.back().invariants)
+                {
+                    result.push_back(std::move(invariant.second));
+                }
+                loops_.pop_back();
+                return result;
+            }
+
+            // Return whether the given pure expression is invariant to any
+            // of the enclosing loops, find the outermost of those.
+            bool find_loop(ast::expression const& expr, std::size_t& l) const
+            {
+                if (suspended_)
+                {
+                    return false;
+                }
+
+                for (std::size_t i = 0; i != loops_.size(); ++i)
+                {
+                    bool uses_variables = false;
+                    std::set<std::string> active;
+                    if (loops_[i].analyzed &&
+                        is_invariant(expr, loops_[i], uses_variables, active) &&
+                        uses_variables)
+                    {
+                        l = i;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Return whether the given variable refers to a value (as
+            // opposed to an expression evaluated whenever it is used).
+            bool refers_to_value(std::string const& name) const
+            {
+                if (expressions_.find(name) != expressions_.end())
+                {
+                    return false;
+                }
+
+                if (values_.find(name) != values_.end())
+                {
+                    return true;
+                }
+
+                // variables which will be created implicitly and variables
+                // initialized with a literal value refer to values, all other
+                // primitives (e.g. function arguments) could refer to
+                // arbitrary expressions
+                auto p = variables_.find(name);
+                if (is_empty_range(p))
+                {
+                    return is_empty_range(functions_.find(name));
+                }
+                return !is_primitive_operand(p.first->second);
+            }
+
+            bool is_loop_invariant(ast::expression const& expr) const
+            {
+                std::size_t l = 0;
+                return find_loop(expr, l);
+            }
+
+            // Generate the given loop invariant expression using the given
+            // function and make it a loop invariant of the given loop.
+            template <typename F>
+            primitive_argument_type hoist(
+                std::size_t l, ast::expression const& expr, F && generate)
+            {
+                for (auto const& invariant : loops_[l].invariants)
+                {
+                    if (invariant.first == expr)
+                    {
+                        return invariant.second;
+                    }
+                }
+
+                // the subexpressions of the expression are invariant as well
+                suspended_ = true;
+                primitive_argument_type value;
+                try
+                {
+                    value = generate();
+                }
+                catch (...)
+                {
+                    suspended_ = false;
+                    throw;
+                }
+                suspended_ = false;
+
+                // literal values don't need to be evaluated at all
+                if (!is_primitive_operand(value))
+                {
+                    return value;
+                }
+
+                primitive_argument_type invariant =
+                    hpx::new_<primitives::loop_invariant>(hpx::find_here(),
+                        std::vector<primitive_argument_type>{
+                            std::move(value)});
+                loops_[l].invariants.emplace_back(expr, invariant);
+                return invariant;
+            }
+
+        private:
+            // Return whether the given expression is pure and depends on
+            // variables not modified by the given loop only.
+            bool is_invariant(ast::expression const& expr, loop const& l,
+                bool& uses_variables, std::set<std::string>& active) const
+            {
+                if (ast::detail::is_literal_value(expr))
+                {
+                    return true;
+                }
+
+                if (ast::detail::is_identifier(expr))
+                {
+                    uses_variables = true;
+                    return is_invariant_variable(
+                        ast::detail::identifier_name(expr), l, uses_variables,
+                        active);
+                }
+
+                for (std::size_t i : patterns_.candidates(expr))
+                {
+                    expression_pattern const& pattern = patterns_.patterns()[i];
+
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
+                            on_placeholder_match{placeholders}))
+                    {
+                        continue;
+                    }
+
+                    if (!is_pure_operation(hpx::util::get<0>(pattern)))
+                    {
+                        return false;
+                    }
+
+                    for (auto const& placeholder : placeholders)
+                    {
+                        if (!is_invariant(
+                                placeholder.second, l, uses_variables, active))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            bool is_invariant_variable(std::string const& name, loop const& l,
+                bool& uses_variables, std::set<std::string>& active) const
+            {
+                if (l.modified.find(name) != l.modified.end())
+                {
+                    return false;
+                }
+
+                // variables referring to expressions are invariant if the
+                // expression is invariant
+                auto it = expressions_.find(name);
+                if (it != expressions_.end())
+                {
+                    if (!active.insert(name).second)
+                    {
+                        return false;
+                    }
+                    bool result =
+                        is_invariant(it->second, l, uses_variables, active);
+                    active.erase(name);
+                    return result;
+                }
+
+                return refers_to_value(name);
+            }
+
+            indexed_pattern_list const& patterns_;
+            phylanx::execution_tree::variables& variables_;
+            phylanx::execution_tree::functions& functions_;
+
+            std::set<std::string> values_;
+            std::map<std::string, ast::expression> expressions_;
+
+            std::vector<loop> loops_;
+            bool suspended_;
+        };
+
+        bool common_subexpressions::refers_to_values(entry const& e) const
+        {
+            for (std::string const& name : e.identifiers)
+            {
+                if (!invariants_.refers_to_value(name))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The shapes of the values computed by the generated primitives, as
+        // far as they are known before evaluating the expression. Values
+        // given for variables which are never modified by the expression
+        // have a fixed shape, the shapes of pure operations are inferred
+        // from the shapes of their arguments (see infer_shape). Invalid
+        // shapes are reported while generating the tree only for code which
+        // is evaluated unconditionally. In the branches of if and in the
+        // bodies of loops they are reported by the primitive when (and if)
+        // it is evaluated.
+        class static_shapes
+        {
+        public:
+            static_shapes(ast::expression const& expr,
+                indexed_pattern_list const& patterns,
+                phylanx::execution_tree::functions& functions)
+              : conditional_(0)
+            {
+                modified_variables(patterns, functions, true)
+                    .collect(expr, modified_);
+            }
+
+            // The given primitive refers to a variable initialized with a
+            // value of the given shape.
+            void define_variable(std::string const& name,
+                primitive_argument_type const& p, static_shape const& shape)
+            {
+                if (modified_.find(name) == modified_.end())
+                {
+                    define(p, shape);
+                }
+            }
+
+            void define(primitive_argument_type const& p,
+                static_shape const& shape)
+            {
+                if (shape && is_primitive_operand(p))
+                {
+                    shapes_[primitive_operand(p).get_id()] = *shape;
+                }
+            }
+
+            static_shape shape(primitive_argument_type const& value) const
+            {
+                if (!is_primitive_operand(value))
+                {
+                    return shape_of(value);
+                }
+
+                auto it = shapes_.find(primitive_operand(value).get_id());
+                if (it != shapes_.end())
+                {
+                    return static_shape(it->second);
+                }
+                return static_shape();
+            }
+
+            // Infer the shape of the value computed by the named pure
+            // operation, throws if the arguments are known to be invalid
+            // and the operation is evaluated unconditionally.
+            static_shape infer(std::string const& name,
+                std::vector<primitive_argument_type> const& arguments) const
+            {
+                std::vector<static_shape> shapes;
+                shapes.reserve(arguments.size());
+                for (auto const& argument : arguments)
+                {
+                    shapes.push_back(shape(argument));
+                }
+                return infer(name, shapes);
+            }
+
+            static_shape infer(std::string const& name,
+                std::vector<static_shape> const& shapes) const
+            {
+                if (conditional_ == 0)
+                {
+                    return infer_shape(name, shapes);
+                }
+
+                try
+                {
+                    return infer_shape(name, shapes);
+                }
+                catch (hpx::exception const&)
+                {
+                    return static_shape();
+                }
+            }
+
+            // Mark the code generated in between as evaluated conditionally.
+            void enter_conditional()
+            {
+                ++conditional_;
+            }
+            void leave_conditional()
+            {
+                --conditional_;
+            }
+
+        private:
+            std::size_t conditional_;
+            std::set<std::string> modified_;
+            std::map<hpx::id_type, ir::node_data<double>::shape_type> shapes_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Operations evaluating their operands one after the other (the
+        // operands of all other operations are evaluated concurrently).
+        bool is_sequential_operation(std::string const& name)
+        {
+            return name == "block" || name == "if" || name == "while" ||
+                name == "for";
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Buffer reuse: a statement storing a new value to a variable, like
+        // 'store(w, w - alpha * g)', uses the old value of the variable for
+        // the last time. If the new value is computed by pure operations
+        // using the variable only once, this use is generated as a
+        // primitives::last_use, which hands over the old value. The operation
+        // consuming it then computes its result in the storage of the old
+        // value instead of allocating a new array.
+        class last_uses
+        {
+        public:
+            last_uses(indexed_pattern_list const& patterns)
+              : patterns_(patterns)
+              , statement_(true)
+            {
+            }
+
+            // The expression generated next is evaluated on its own only if
+            // it is an operand of a sequential operation evaluated on its
+            // own. Returns the previous state.
+            bool enter_operands(bool sequential)
+            {
+                bool const statement = statement_;
+                statement_ = statement_ && sequential;
+                return statement;
+            }
+
+            void leave_operands(bool statement)
+            {
+                statement_ = statement;
+            }
+
+            // Start generating the value stored to the given variable, return
+            // whether the old value of the variable is used for the last
+            // time. Variables of enclosing scopes could be used concurrently
+            // by the expression invoking a function.
+            bool enter_store(std::string const& name,
+                ast::expression const& value,
+                phylanx::execution_tree::variables const& variables,
+                common_subexpressions const& subexpressions,
+                loop_invariants const& invariants)
+            {
+                std::size_t uses = 0;
+                if (!statement_ || !variables.defines(name) ||
+                    !invariants.refers_to_value(name) ||
+                    !uses_once(name, value, subexpressions, invariants, uses) ||
+                    uses != 1)
+                {
+                    return false;
+                }
+
+                donated_ = name;
+                return true;
+            }
+
+            void leave_store()
+            {
+                donated_.clear();
+            }
+
+            // Return whether the given variable is used for the last time.
+            bool is_last_use(std::string const& name)
+            {
+                if (donated_.empty() || donated_ != name)
+                {
+                    return false;
+                }
+                donated_.clear();
+                return true;
+            }
+
+        private:
+            // Return whether the given expression consists of pure operations
+            // only, which aren't shared with other expressions and which
+            // don't refer to anything evaluated concurrently, count the uses
+            // of the given variable.
+            bool uses_once(std::string const& name,
+                ast::expression const& expr,
+                common_subexpressions const& subexpressions,
+                loop_invariants const& invariants, std::size_t& uses) const
+            {
+                if (ast::detail::is_literal_value(expr))
+                {
+                    return true;
+                }
+
+                if (ast::detail::is_identifier(expr))
+                {
+                    std::string id = ast::detail::identifier_name(expr);
+                    if (id == name)
+                    {
+                        ++uses;
+                        return true;
+                    }
+                    return invariants.refers_to_value(id);
+                }
+
+                if (subexpressions.is_common(expr))
+                {
+                    return false;
+                }
+
+                for (std::size_t i : patterns_.candidates(expr))
+                {
+                    expression_pattern const& pattern = patterns_.patterns()[i];
+
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
+                            on_placeholder_match{placeholders}))
+                    {
+                        continue;
+                    }
+
+                    if (!is_pure_operation(hpx::util::get<0>(pattern)))
+                    {
+                        return false;
+                    }
+
+                    for (auto const& placeholder : placeholders)
+                    {
+                        if (!uses_once(name, placeholder.second,
+                                subexpressions, invariants, uses))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            indexed_pattern_list const& patterns_;
+            bool statement_;
+            std::string donated_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // State shared while generating the tree for one expression.
+        struct generation_context
+        {
+            generation_context(ast::expression const& expr,
+                    indexed_pattern_list const& patterns,
+                    phylanx::execution_tree::variables& variables,
+                    phylanx::execution_tree::functions& functions)
+              : invariants(patterns, variables, functions)
+              , subexpressions(expr, patterns, invariants)
+              , shapes(expr, patterns, functions)
+              , uses(patterns)
+            {
+            }
+
+            loop_invariants invariants;
+            common_subexpressions subexpressions;
+            static_shapes shapes;
+            last_uses uses;
+        };
+
+        // Generate the operands of an operation as operands of a sequential
+        // operation or not.
+        class operands_scope
+        {
+        public:
+            operands_scope(generation_context& context, bool sequential)
+              : uses_(context.uses)
+              , statement_(uses_.enter_operands(sequential))
+            {
+            }
+            ~operands_scope()
+            {
+                uses_.leave_operands(statement_);
+            }
+
+        private:
+            last_uses& uses_;
+            bool statement_;
+        };
+
+        // Generate the operands of an operation which are evaluated only
+        // conditionally (see static_shapes).
+        class conditional_scope
+        {
+        public:
+            conditional_scope(generation_context& context, bool conditional)
+              : shapes_(context.shapes)
+              , conditional_(conditional)
+            {
+                if (conditional_)
+                {
+                    shapes_.enter_conditional();
+                }
+            }
+            ~conditional_scope()
+            {
+                if (conditional_)
+                {
+                    shapes_.leave_conditional();
+                }
+            }
+
+        private:
+            static_shapes& shapes_;
+            bool conditional_;
+        };
+
+        // The index of the first operand of the named operation which is
+        // evaluated only conditionally: the branches of if and the bodies of
+        // loops (including the step of for).
+        std::size_t first_conditional_operand(std::string const& name)
+        {
+            if (name == "if" || name == "while")
+            {
+                return 1;
+            }
+            if (name == "for")
+            {
+                return 2;
+            }
+            return std::size_t(-1);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::vector<primitive_argument_type> generate_arguments(
+            std::multimap<std::string, ast::expression>& placeholders,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions,
+            indexed_pattern_list const& patterns,
+            expression_pattern const& pattern,
+            generation_context& context)
+        {
+            std::vector<primitive_argument_type> arguments;
+            arguments.reserve(placeholders.size());
+
+            std::size_t const first_conditional =
+                first_conditional_operand(hpx::util::get<0>(pattern));
+
+            for (auto const& placeholder : placeholders)
+            {
+                conditional_scope scope(
+                    context, arguments.size() >= first_conditional);
+
+                if (ast::detail::is_literal_value(placeholder.second))
+                {
+                    arguments.push_back(to_primitive_value_type(
+                        ast::detail::literal_value(placeholder.second)));
+                }
+                else
+                {
+                    arguments.push_back(generate_expression(placeholder.second,
+                        patterns, variables, functions, context));
+                }
+            }
+
+            return arguments;
+        }
+
+        // Create the primitive for the given pattern. Pure operations are
+        // evaluated right away if all of their arguments are literal values,
+        // their arguments are checked for compatible shapes.
+        primitive_argument_type create_primitive(
+            std::vector<primitive_argument_type>&& arguments,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions,
+            expression_pattern const& pattern,
+            generation_context& context)
+        {
+            std::string const& name = hpx::util::get<0>(pattern);
+            bool const pure = is_pure_operation(name);
+
+            static_shape shape;
+            if (pure)
+            {
+                shape = context.shapes.infer(name, arguments);
+            }
+
+            bool const fold = pure && all_literal_values(arguments);
+
+            // create primitive with given arguments
+            primitive_argument_type result = hpx::util::get<3>(pattern)(
+                hpx::find_here(), std::move(arguments), variables, functions);
 
-            for (auto const& patterns : patterns_list)
+            if (fold)
             {
-                for (auto const& pattern : patterns)
-                {
-                    result.push_back(
-                        hpx::util::make_tuple(
-                            hpx::util::get<0>(pattern),
-                            hpx::util::get<1>(pattern),
-                            ast::generate_ast(hpx::util::get<1>(pattern)),
-                            hpx::util::get<2>(pattern)));
-                }
+                return fold_constant(std::move(result));
             }
 
+            context.shapes.define(result, shape);
             return result;
         }
 
+        primitive_argument_type handle_placeholders(
+            std::multimap<std::string, ast::expression>& placeholders,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions,
+            indexed_pattern_list const& patterns,
+            expression_pattern const& pattern,
+            generation_context& context)
+        {
+            return create_primitive(
+                generate_arguments(placeholders, variables, functions,
+                    patterns, pattern, context),
+                variables, functions, pattern, context);
+        }
+
         ///////////////////////////////////////////////////////////////////////
-        struct on_placeholder_match
+        // The loop invariant subexpressions of a loop are evaluated at most
+        // once per execution of the loop, the loop resets them whenever it
+        // starts iterating.
+        primitive_argument_type handle_loop(ast::expression const& expr,
+            std::multimap<std::string, ast::expression>& placeholders,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions,
+            indexed_pattern_list const& patterns,
+            expression_pattern const& pattern,
+            generation_context& context)
         {
-            std::multimap<std::string, ast::expression>& placeholders;
+            context.invariants.enter_loop(expr);
+            std::vector<primitive_argument_type> arguments = generate_arguments(
+                placeholders, variables, functions, patterns, pattern, context);
+            std::vector<primitive_argument_type> invariants =
+                context.invariants.leave_loop();
 
-            template <typename Ast1, typename Ast2, typename... Ts>
-            bool operator()(
-                Ast1 const& ast1, Ast2 const& ast2, Ts const&... ts) const
+            if (invariants.empty())
             {
-                using value_type = typename std::multimap<std::string,
-                    ast::expression>::value_type;
+                return hpx::util::get<3>(pattern)(hpx::find_here(),
+                    std::move(arguments), variables, functions);
+            }
 
-                if (ast::detail::is_placeholder(ast1))
+            if (hpx::util::get<0>(pattern) == "while")
+            {
+                return hpx::new_<primitives::while_operation>(hpx::find_here(),
+                    std::move(arguments), std::move(invariants));
+            }
+            return hpx::new_<primitives::for_operation>(hpx::find_here(),
+                std::move(arguments), std::move(invariants));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Element-wise operations are fused into a single primitive (see
+        // primitives::fused_operation), this avoids creating intermediate
+        // arrays while evaluating expressions like '1.0 / (1.0 + exp(-x))'.
+        using fused_opcode = primitives::fused_instruction::opcode;
+
+        bool is_fusible_operation(std::string const& name, fused_opcode& op)
+        {
+            if (name == "add")
+            {
+                op = fused_opcode::add;
+            }
+            else if (name == "sub")
+            {
+                op = fused_opcode::sub;
+            }
+            else if (name == "mul")
+            {
+                op = fused_opcode::mul;
+            }
+            else if (name == "div")
+            {
+                op = fused_opcode::div;
+            }
+            else if (name == "unary_minus")
+            {
+                op = fused_opcode::negate;
+            }
+            else if (name == "exp")
+            {
+                op = fused_opcode::exp;
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
+        char const* fused_operation_name(fused_opcode op)
+        {
+            switch (op)
+            {
+            case fused_opcode::add: return "add";
+            case fused_opcode::sub: return "sub";
+            case fused_opcode::mul: return "mul";
+            case fused_opcode::div: return "div";
+            case fused_opcode::negate: return "unary_minus";
+            case fused_opcode::exp: return "exp";
+            default: break;
+            }
+            return "";
+        }
+
+        // Find the pattern generate_tree would use for the given expression,
+        // return whether this is an element-wise operation.
+        bool match_fusible_operation(ast::expression const& expr,
+            indexed_pattern_list const& patterns,
+            std::multimap<std::string, ast::expression>& placeholders,
+            fused_opcode& op)
+        {
+            for (std::size_t i : patterns.candidates(expr))
+            {
+                expression_pattern const& pattern = patterns.patterns()[i];
+
+                std::multimap<std::string, ast::expression> matched;
+                if (ast::match_ast(expr, hpx::util::get<2>(pattern),
+                        on_placeholder_match{matched}))
                 {
-                    if (ast::detail::is_placeholder_ellipses(ast1))
-                    {
-                        placeholders.insert(value_type(
-                            ast::detail::identifier_name(ast1).substr(1),
-                            ast::expression(ast2)));
-                    }
-                    else
-                    {
-                        placeholders.insert(
-                            value_type(ast::detail::identifier_name(ast1),
-                                ast::expression(ast2)));
-                    }
+                    placeholders = std::move(matched);
+                    return is_fusible_operation(hpx::util::get<0>(pattern), op);
                 }
-                else if (ast::detail::is_placeholder(ast2))
+            }
+            return false;
+        }
+
+        // Collect the program for the tree of element-wise operations rooted
+        // in the given (already matched) operation. All other expressions
+        // become operands of the fused primitive.
+        void build_fused_program(fused_opcode op,
+            std::multimap<std::string, ast::expression> const& placeholders,
+            indexed_pattern_list const& patterns,
+            generation_context const& context,
+            std::vector<ast::expression>& leaves,
+            std::vector<primitives::fused_instruction>& program)
+        {
+            std::vector<std::size_t> args;
+            args.reserve(placeholders.size());
+
+            for (auto const& placeholder : placeholders)
+            {
+                // common subexpressions and loop invariants are shared, not
+                // inlined
+                std::multimap<std::string, ast::expression> nested;
+                fused_opcode nested_op;
+                if (!context.subexpressions.is_common(placeholder.second) &&
+                    !context.invariants.is_loop_invariant(placeholder.second) &&
+                    match_fusible_operation(
+                        placeholder.second, patterns, nested, nested_op))
                 {
-                    if (ast::detail::is_placeholder_ellipses(ast1))
+                    std::vector<ast::expression> nested_leaves;
+                    std::vector<primitives::fused_instruction> nested_program;
+                    build_fused_program(nested_op, nested, patterns,
+                        context, nested_leaves, nested_program);
+
+                    // subexpressions of literals only are folded separately
+                    if (std::all_of(nested_leaves.begin(), nested_leaves.end(),
+                            [](ast::expression const& leaf)
+                            {
+                                return ast::detail::is_literal_value(leaf);
+                            }))
                     {
-                        placeholders.insert(value_type(
-                            ast::detail::identifier_name(ast2).substr(1),
-                            ast::expression(ast1)));
+                        leaves.push_back(placeholder.second);
+                        program.emplace_back(fused_opcode::load,
+                            std::vector<std::size_t>{leaves.size() - 1});
                     }
                     else
                     {
-                        placeholders.insert(
-                            value_type(ast::detail::identifier_name(ast2),
-                                ast::expression(ast1)));
+                        std::size_t const leaves_offset = leaves.size();
+                        std::size_t const program_offset = program.size();
+
+                        for (auto& inst : nested_program)
+                        {
+                            for (std::size_t& arg : inst.args)
+                            {
+                                arg += (inst.op == fused_opcode::load) ?
+                                    leaves_offset : program_offset;
+                            }
+                            program.push_back(std::move(inst));
+                        }
+
+                        leaves.insert(leaves.end(),
+                            std::make_move_iterator(nested_leaves.begin()),
+                            std::make_move_iterator(nested_leaves.end()));
                     }
                 }
-                return true;
+                else
+                {
+                    leaves.push_back(placeholder.second);
+                    program.emplace_back(fused_opcode::load,
+                        std::vector<std::size_t>{leaves.size() - 1});
+                }
+                args.push_back(program.size() - 1);
             }
-        };
 
-        ///////////////////////////////////////////////////////////////////////
-        primitive_argument_type handle_placeholders(
+            program.emplace_back(op, std::move(args));
+        }
+
+        // Infer the shapes of all values computed by the given program from
+        // the shapes of its operands. Returns whether all of them are known
+        // and all instructions are known to be element-wise.
+        bool infer_fused_shapes(
+            std::vector<primitives::fused_instruction> const& program,
+            std::vector<primitive_argument_type> const& arguments,
+            generation_context const& context,
+            std::vector<primitives::fused_operation::shape_type>& shapes,
+            static_shape& result)
+        {
+            std::vector<static_shape> values;
+            values.reserve(program.size());
+
+            for (auto const& inst : program)
+            {
+                if (inst.op == fused_opcode::load)
+                {
+                    values.push_back(
+                        context.shapes.shape(arguments[inst.args[0]]));
+                    continue;
+                }
+
+                std::vector<static_shape> args;
+                args.reserve(inst.args.size());
+                for (std::size_t arg : inst.args)
+                {
+                    args.push_back(values[arg]);
+                }
+                values.push_back(
+                    context.shapes.infer(fused_operation_name(inst.op), args));
+            }
+
+            result = values.back();
+
+            shapes.reserve(values.size());
+            for (auto const& value : values)
+            {
+                if (!value)
+                {
+                    return false;
+                }
+                shapes.push_back(*value);
+            }
+
+            for (std::size_t i = 0; i != program.size(); ++i)
+            {
+                primitives::fused_operation::shape_type shape;
+                if (program[i].op != fused_opcode::load &&
+                    (!primitives::fused_operation::elementwise_shape(
+                            program[i], shapes, shape) ||
+                        shape != shapes[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        primitive_argument_type handle_fusible_operation(
             std::multimap<std::string, ast::expression>& placeholders,
             phylanx::execution_tree::variables& variables,
             phylanx::execution_tree::functions& functions,
-            expression_pattern_list const& patterns,
-            expression_pattern const& pattern)
+            indexed_pattern_list const& patterns,
+            expression_pattern const& pattern, fused_opcode op,
+            generation_context& context)
         {
+            std::vector<ast::expression> leaves;
+            std::vector<primitives::fused_instruction> program;
+            build_fused_program(
+                op, placeholders, patterns, context, leaves, program);
+
             std::vector<primitive_argument_type> arguments;
-            arguments.reserve(placeholders.size());
+            arguments.reserve(leaves.size());
 
-            for (auto const& placeholder : placeholders)
+            for (auto const& leaf : leaves)
             {
-                if (ast::detail::is_literal_value(placeholder.second))
+                if (ast::detail::is_literal_value(leaf))
                 {
                     arguments.push_back(to_primitive_value_type(
-                        ast::detail::literal_value(placeholder.second)));
+                        ast::detail::literal_value(leaf)));
                 }
                 else
                 {
-                    arguments.push_back(generate_tree(
-                        placeholder.second, patterns, variables, functions));
+                    arguments.push_back(generate_expression(
+                        leaf, patterns, variables, functions, context));
                 }
             }
 
-            // create primitive with given arguments
-            return hpx::util::get<3>(pattern)(
-                hpx::find_here(), std::move(arguments), variables, functions);
+            // if the shapes of all values are known the fused primitive
+            // doesn't need to determine them while being evaluated
+            std::vector<primitives::fused_operation::shape_type> shapes;
+            static_shape shape;
+            bool const specialize =
+                infer_fused_shapes(program, arguments, context, shapes, shape);
+
+            // a single operation is not worth fusing, the leaves are its
+            // arguments
+            if (!specialize && program.size() - leaves.size() < 2)
+            {
+                return create_primitive(std::move(arguments), variables,
+                    functions, pattern, context);
+            }
+
+            bool const fold = all_literal_values(arguments);
+
+            primitive_argument_type result;
+            if (specialize)
+            {
+                result = hpx::new_<primitives::fused_operation>(
+                    hpx::find_here(), std::move(arguments),
+                    std::move(program), std::move(shapes));
+            }
+            else
+            {
+                result = hpx::new_<primitives::fused_operation>(
+                    hpx::find_here(), std::move(arguments),
+                    std::move(program));
+            }
+
+            if (fold)
+            {
+                return fold_constant(std::move(result));
+            }
+
+            context.shapes.define(result, shape);
+            return result;
         }
 
         ///////////////////////////////////////////////////////////////////////
         primitive_argument_type handle_variable(ast::expression const& expr,
             phylanx::execution_tree::variables& variables,
-            phylanx::execution_tree::functions& functions)
+            phylanx::execution_tree::functions& functions,
+            generation_context& context)
         {
             std::string name = ast::detail::identifier_name(expr);
             auto p = variables.find(name);
@@ -138,11 +1722,24 @@ namespace phylanx { namespace execution_tree
             {
                 if (!is_primitive_operand(p.first->second))
                 {
+                    context.invariants.define_value(name);
+                    static_shape shape = shape_of(p.first->second);
+
                     // create a new variable from the given value, replace
                     // entry in symbol table
                     p.first->second =
                         hpx::new_<primitives::variable>(hpx::find_here(),
-                            std::move(p.first->second), std::move(name));
+                            std::move(p.first->second), name);
+                    context.shapes.define_variable(
+                        name, p.first->second, shape);
+                }
+
+                if (context.uses.is_last_use(name))
+                {
+                    return primitive_argument_type{
+                        hpx::new_<primitives::last_use>(hpx::find_here(),
+                            std::vector<primitive_argument_type>{
+                                p.first->second})};
                 }
                 return p.first->second;
             }
@@ -155,6 +1752,7 @@ namespace phylanx { namespace execution_tree
                 // create an empty variable
                 primitive p =
                     hpx::new_<primitives::variable>(hpx::find_here(), name);
+                context.invariants.define_value(name);
 
                 // attempt to insert the new variable into the symbol table
                 auto r = variables.insert(
@@ -169,6 +1767,60 @@ namespace phylanx { namespace execution_tree
             }
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Handle store(_1, _2), the old value of the target variable is handed
+        // over to the new value if it is used for the last time.
+        primitive_argument_type handle_store(
+            std::multimap<std::string, ast::expression>& placeholders,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions,
+            indexed_pattern_list const& patterns,
+            expression_pattern const& pattern,
+            generation_context& context)
+        {
+            auto target = placeholders.find("_1");
+            auto value = placeholders.find("_2");
+            if (target == placeholders.end() || value == placeholders.end() ||
+                !ast::detail::is_identifier(target->second))
+            {
+                operands_scope scope(context, false);
+                return handle_placeholders(placeholders, variables, functions,
+                    patterns, pattern, context);
+            }
+
+            // the target is generated first, this creates the variable if
+            // needed
+            std::vector<primitive_argument_type> arguments;
+            arguments.reserve(2);
+            arguments.push_back(generate_expression(
+                target->second, patterns, variables, functions, context));
+
+            bool const last_use = context.uses.enter_store(
+                ast::detail::identifier_name(target->second), value->second,
+                variables, context.subexpressions, context.invariants);
+
+            operands_scope scope(context, false);
+
+            if (ast::detail::is_literal_value(value->second))
+            {
+                arguments.push_back(to_primitive_value_type(
+                    ast::detail::literal_value(value->second)));
+            }
+            else
+            {
+                arguments.push_back(generate_expression(
+                    value->second, patterns, variables, functions, context));
+            }
+
+            if (last_use)
+            {
+                context.uses.leave_store();
+            }
+
+            return create_primitive(std::move(arguments), variables,
+                functions, pattern, context);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <typename Iterator>
         ast::expression extract_name(std::pair<Iterator, Iterator> const& p)
@@ -243,7 +1895,8 @@ namespace phylanx { namespace execution_tree
             ast::expression && nameexpr, ast::expression && bodyexpr,
             phylanx::execution_tree::variables& variables,
             phylanx::execution_tree::functions& functions,
-            expression_pattern_list const& patterns)
+            indexed_pattern_list const& patterns,
+            generation_context& context)
         {
             std::string name = ast::detail::identifier_name(nameexpr);
             auto pv = variables.find(name);
@@ -256,8 +1909,19 @@ namespace phylanx { namespace execution_tree
             }
 
             // create a new variable from the given expression (body)
-            primitive_argument_type p =
-                generate_tree(bodyexpr, patterns, variables, functions);
+            primitive_argument_type p = generate_expression(
+                bodyexpr, patterns, variables, functions, context);
+
+            if (valid(p) && !is_primitive_operand(p))
+            {
+                p = hpx::new_<primitives::variable>(
+                    hpx::find_here(), std::move(p));
+                context.invariants.define_value(name);
+            }
+            else
+            {
+                context.invariants.define_expression(name, bodyexpr);
+            }
 
             if (!is_primitive_operand(p))
             {
@@ -282,8 +1946,9 @@ namespace phylanx { namespace execution_tree
             std::multimap<std::string, ast::expression>& placeholders,
             phylanx::execution_tree::variables& variables,
             phylanx::execution_tree::functions& functions,
-            expression_pattern_list const& patterns,
-            expression_pattern const& pattern)
+            indexed_pattern_list const& patterns,
+            expression_pattern const& pattern,
+            generation_context& context)
         {
             // we know that 'define()' uses '__1' to match arguments
             using iterator =
@@ -299,7 +1964,7 @@ namespace phylanx { namespace execution_tree
             if (args.empty())
             {
                 return handle_define_variable(std::move(name), std::move(body),
-                    variables, functions, patterns);
+                    variables, functions, patterns, context);
             }
 
             // store new function description for later use
@@ -326,9 +1991,33 @@ namespace phylanx { namespace execution_tree
             phylanx::execution_tree::variables& variables,
             phylanx::execution_tree::functions& functions)
         {
-            primitive_argument_type result;
-            for (auto const& pattern : patterns)
+            return generate_tree(expr, indexed_pattern_list(patterns),
+                variables, functions);
+        }
+
+        // Share the primitive generated for a common subexpression, the
+        // shared primitive computes a value of the same shape.
+        primitive_argument_type share_value(ast::expression const& expr,
+            primitive_argument_type && value, generation_context& context)
+        {
+            static_shape shape = context.shapes.shape(value);
+            primitive_argument_type result =
+                context.subexpressions.share(expr, std::move(value));
+            context.shapes.define(result, shape);
+            return result;
+        }
+
+        primitive_argument_type generate_expression(
+            ast::expression const& expr,
+            indexed_pattern_list const& patterns,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions,
+            generation_context& context)
+        {
+            for (std::size_t i : patterns.candidates(expr))
             {
+                expression_pattern const& pattern = patterns.patterns()[i];
+
                 std::multimap<std::string, ast::expression> placeholders;
                 if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
                         on_placeholder_match{placeholders}))
@@ -337,27 +2026,84 @@ namespace phylanx { namespace execution_tree
                 }
 
                 // Handle define(__1)
-                if (hpx::util::get<0>(pattern) == "define")
+                std::string const& name = hpx::util::get<0>(pattern);
+                if (name == "define")
+                {
+                    return handle_define(placeholders, variables, functions,
+                        patterns, pattern, context);
+                }
+
+                // Handle loops, while(_1, _2) and for(_1, _2, _3, _4)
+                if (name == "while" || name == "for")
+                {
+                    return handle_loop(expr, placeholders, variables,
+                        functions, patterns, pattern, context);
+                }
+
+                // Handle store(_1, _2)
+                if (name == "store")
+                {
+                    return handle_store(placeholders, variables, functions,
+                        patterns, pattern, context);
+                }
+
+                operands_scope scope(context, is_sequential_operation(name));
+
+                // Hoist loop invariants out of the enclosing loops
+                std::size_t loop = 0;
+                if (is_pure_operation(name) &&
+                    context.invariants.find_loop(expr, loop))
+                {
+                    static_shape shape;
+                    primitive_argument_type result =
+                        context.invariants.hoist(loop, expr,
+                            [&]()
+                            {
+                                primitive_argument_type value =
+                                    generate_expression(expr, patterns,
+                                        variables, functions, context);
+                                shape = context.shapes.shape(value);
+                                return value;
+                            });
+                    context.shapes.define(result, shape);
+                    return result;
+                }
+
+                // Reuse the primitive of a common subexpression
+                primitive_argument_type const* shared =
+                    context.subexpressions.shared_value(expr);
+                if (shared != nullptr)
                 {
-                    return handle_define(
-                        placeholders, variables, functions, patterns, pattern);
+                    return *shared;
                 }
 
-                return handle_placeholders(
-                    placeholders, variables, functions, patterns, pattern);
+                // Fuse trees of element-wise operations
+                fused_opcode op;
+                if (is_fusible_operation(name, op))
+                {
+                    return share_value(expr,
+                        handle_fusible_operation(placeholders, variables,
+                            functions, patterns, pattern, op, context),
+                        context);
+                }
+
+                return share_value(expr,
+                    handle_placeholders(placeholders, variables, functions,
+                        patterns, pattern, context),
+                    context);
             }
 
             // remaining expression could refer to a variable
             if (ast::detail::is_identifier(expr))
             {
-                return handle_variable(expr, variables, functions);
+                return handle_variable(expr, variables, functions, context);
             }
 
             // alternatively it could refer to a literal value
             if (ast::detail::is_literal_value(expr))
             {
-                return hpx::new_<primitives::variable>(hpx::find_here(),
-                    to_primitive_value_type(ast::detail::literal_value(expr)));
+                return to_primitive_value_type(
+                    ast::detail::literal_value(expr));
             }
 
             // otherwise the match was not complete, bail out
@@ -366,52 +2112,169 @@ namespace phylanx { namespace execution_tree
                 "couldn't fully pattern-match the given expression: " +
                     ast::to_string(expr));
         }
+
+        primitive_argument_type generate_tree(
+            ast::expression const& expr,
+            indexed_pattern_list const& patterns,
+            phylanx::execution_tree::variables& variables,
+            phylanx::execution_tree::functions& functions)
+        {
+            // The value of a complete expression is represented by a
+            // primitive. Literal values and folded constants are wrapped into
+            // a variable, the names of functions (strings) are returned as is.
+            generation_context context(expr, patterns, variables, functions);
+            primitive_argument_type result = generate_expression(
+                expr, patterns, variables, functions, context);
+
+            if (valid(result) && !is_primitive_operand(result) &&
+                (ast::detail::is_literal_value(expr) ||
+                    result.index() != 3))
+            {
+                return hpx::new_<primitives::variable>(
+                    hpx::find_here(), std::move(result));
+            }
+            return result;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    pattern_list const& get_all_known_patterns()
+    namespace detail
     {
-        static pattern_list patterns = {
-            // variadic functions
-            primitives::block_operation::match_data,
-            primitives::parallel_block_operation::match_data,
-            primitives::define_::match_data,
-            // binary functions
-            primitives::dot_operation::match_data,
-            primitives::file_read::match_data,
-            primitives::file_write::match_data,
-            primitives::while_operation::match_data,
-            // unary functions
-            primitives::constant::match_data,
-            primitives::determinant::match_data,
-            primitives::exponential_operation::match_data,
-            primitives::inverse_operation::match_data,
-            primitives::transpose_operation::match_data,
-            primitives::random::match_data,
-            // variadic operations
-            primitives::add_operation::match_data,
-            primitives::and_operation::match_data,
-            primitives::div_operation::match_data,
-            primitives::mul_operation::match_data,
-            primitives::or_operation::match_data,
-            primitives::sub_operation::match_data,
-            // binary operations
-            primitives::equal::match_data,
-            primitives::greater::match_data,
-            primitives::greater_equal::match_data,
-            primitives::less::match_data,
-            primitives::less_equal::match_data,
-            primitives::not_equal::match_data,
-            primitives::store_operation::match_data,
-            // unary operations
-            primitives::unary_minus_operation::match_data,
-            primitives::unary_not_operation::match_data,
-            // must be last, otherwise it might intercept some predefined
-            // function
-            primitives::define_::invocation_match_data
+        pattern_list builtin_patterns()
+        {
+            return pattern_list{
+                // variadic functions
+                primitives::bicgstab::match_data,
+                primitives::block_operation::match_data,
+                primitives::conjugate_gradient::match_data,
+                primitives::parallel_block_operation::match_data,
+                primitives::define_::match_data,
+                // binary functions, solve must precede dot as it replaces
+                // dot(inverse(_1), _2)
+                primitives::solve_operation::match_data,
+                primitives::dot_operation::match_data,
+                primitives::file_read::match_data,
+                primitives::file_write::match_data,
+                primitives::while_operation::match_data,
+                // unary functions
+                primitives::cholesky_factorization::match_data,
+                primitives::constant::match_data,
+                primitives::determinant::match_data,
+                primitives::exponential_operation::match_data,
+                primitives::inverse_operation::match_data,
+                primitives::lu_decompose::match_data,
+                primitives::lu_factorization::match_data,
+                primitives::qr_decompose::match_data,
+                primitives::transpose_operation::match_data,
+                primitives::random::match_data,
+                // variadic operations
+                primitives::add_operation::match_data,
+                primitives::and_operation::match_data,
+                primitives::div_operation::match_data,
+                primitives::mul_operation::match_data,
+                primitives::or_operation::match_data,
+                primitives::sub_operation::match_data,
+                // binary operations
+                primitives::equal::match_data,
+                primitives::greater::match_data,
+                primitives::greater_equal::match_data,
+                primitives::less::match_data,
+                primitives::less_equal::match_data,
+                primitives::not_equal::match_data,
+                primitives::store_operation::match_data,
+                // unary operations
+                primitives::unary_minus_operation::match_data,
+                primitives::unary_not_operation::match_data,
+                // must be last, otherwise it might intercept some predefined
+                // function
+                primitives::define_::invocation_match_data
+            };
+        }
+
+        // The list of all known patterns, both in their textual and their
+        // parsed form. The parsed list is shared with all users and is never
+        // modified, registering new patterns creates a new list.
+        class known_patterns
+        {
+        private:
+            using mutex_type = hpx::lcos::local::spinlock;
+
+        public:
+            known_patterns()
+              : patterns_(builtin_patterns())
+              , expression_patterns_(
+                    std::make_shared<indexed_pattern_list const>(
+                        generate_patterns(patterns_)))
+            {
+            }
+
+            pattern_list patterns() const
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return patterns_;
+            }
+
+            std::shared_ptr<indexed_pattern_list const>
+                expression_patterns() const
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return expression_patterns_;
+            }
+
+            void add(std::vector<match_pattern_type> const& patterns)
+            {
+                expression_pattern_list new_patterns =
+                    generate_patterns(pattern_list{patterns});
+
+                // the function invocation patterns have to stay last
+                std::size_t const invocation_patterns =
+                    primitives::define_::invocation_match_data.size();
+
+                std::lock_guard<mutex_type> l(mtx_);
+
+                HPX_ASSERT(!patterns_.empty() &&
+                    patterns_.back().size() == invocation_patterns);
+                patterns_.insert(patterns_.end() - 1, patterns);
+
+                expression_pattern_list result(
+                    expression_patterns_->patterns());
+                HPX_ASSERT(result.size() >= invocation_patterns);
+                result.insert(result.end() - invocation_patterns,
+                    std::make_move_iterator(new_patterns.begin()),
+                    std::make_move_iterator(new_patterns.end()));
+
+                expression_patterns_ =
+                    std::make_shared<indexed_pattern_list const>(
+                        std::move(result));
+            }
+
+        private:
+            mutable mutex_type mtx_;
+            pattern_list patterns_;
+            std::shared_ptr<indexed_pattern_list const> expression_patterns_;
         };
 
-        return patterns;
+        known_patterns& get_known_patterns()
+        {
+            static known_patterns patterns;
+            return patterns;
+        }
+
+        std::shared_ptr<indexed_pattern_list const>
+            get_all_known_expression_patterns()
+        {
+            return get_known_patterns().expression_patterns();
+        }
+    }
+
+    pattern_list get_all_known_patterns()
+    {
+        return detail::get_known_patterns().patterns();
+    }
+
+    void register_patterns(std::vector<match_pattern_type> const& patterns)
+    {
+        detail::get_known_patterns().add(patterns);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -420,7 +2283,7 @@ namespace phylanx { namespace execution_tree
         phylanx::execution_tree::variables vars;
         phylanx::execution_tree::functions funcs;
         return detail::generate_tree(ast::generate_ast(exprstr),
-            detail::generate_patterns(get_all_known_patterns()), vars, funcs);
+            *detail::get_all_known_expression_patterns(), vars, funcs);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -430,7 +2293,7 @@ namespace phylanx { namespace execution_tree
         phylanx::execution_tree::variables vars(variables);
         phylanx::execution_tree::functions funcs;
         return detail::generate_tree(ast::generate_ast(exprstr),
-            detail::generate_patterns(get_all_known_patterns()), vars, funcs);
+            *detail::get_all_known_expression_patterns(), vars, funcs);
     }
 
     primitive_argument_type generate_tree(ast::expression const& expr,
@@ -461,7 +2324,7 @@ namespace phylanx { namespace execution_tree
         phylanx::execution_tree::variables vars(variables);
         phylanx::execution_tree::functions funcs(functions);
         return detail::generate_tree(ast::generate_ast(exprstr),
-            detail::generate_patterns(get_all_known_patterns()), vars, funcs);
+            *detail::get_all_known_expression_patterns(), vars, funcs);
     }
 
     primitive_argument_type generate_tree(ast::expression const& expr,
@@ -5,6 +5,9 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/add_operation.hpp>
+#include <phylanx/execution_tree/primitives/detail/combine_elements.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
+#include <phylanx/execution_tree/primitives/detail/typed_elementwise.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/optional.hpp>
 #include <phylanx/util/serialization/eigen.hpp>
@@ -14,6 +17,7 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <numeric>
@@ -83,7 +87,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_result_type add0d0d(operands_type && ops) const
             {
                 operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
+                operand_type const& rhs = ops[1];
 
                 if (ops.size() == 2)
                 {
@@ -111,7 +115,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a vector only if there are exactly 2 operands");
                 }
 
-                ops[1].matrix().array() = ops[0][0] + ops[1].matrix().array();
+                double const value = ops[0][0];
+                transform(ops[1],
+                    [value](array_segment const& x)
+                    {
+                        return value + x;
+                    });
                 return primitive_result_type(std::move(ops[1]));
             }
 
@@ -125,7 +134,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a matrix only if there are exactly 2 operands");
                 }
 
-                ops[1].matrix().array() = ops[0][0] + ops[1].matrix().array();
+                double const value = ops[0][0];
+                transform(ops[1],
+                    [value](array_segment const& x)
+                    {
+                        return value + x;
+                    });
+                return primitive_result_type(std::move(ops[1]));
+            }
+
+            primitive_result_type add0dnd(operands_type && ops) const
+            {
+                if (ops.size() != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "add_operation::add0dnd",
+                        "the add_operation primitive can add a single value "
+                            "to an array only if there are exactly 2 operands");
+                }
+
+                double const value = ops[0][0];
+                transform(ops[1],
+                    [value](array_segment const& x)
+                    {
+                        return value + x;
+                    });
                 return primitive_result_type(std::move(ops[1]));
             }
 
@@ -144,9 +177,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     return add0d2d(std::move(ops));
 
                 default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "add_operation::add0d",
-                        "the operands have incompatible number of dimensions");
+                    return add0dnd(std::move(ops));
                 }
             }
 
@@ -161,19 +192,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a vector only if there are exactly 2 operands");
                 }
 
-                ops[0].matrix().array() += ops[1][0];
+                double const value = ops[1][0];
+                transform(ops[0],
+                    [value](array_segment const& x)
+                    {
+                        return x + value;
+                    });
                 return primitive_result_type(std::move(ops[0]));
             }
 
             primitive_result_type add1d1d(operands_type && ops) const
             {
                 operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
+                operand_type const& rhs = ops[1];
 
-                std::size_t lhs_size = lhs.dimension(0);
-                std::size_t rhs_size = rhs.dimension(0);
-
-                if (lhs_size != rhs_size)
+                auto lhs_size = lhs.dimensions();
+                if (std::any_of(ops.begin() + 1, ops.end(),
+                        [&](operand_type const& op)
+                        {
+                            return op.dimensions() != lhs_size;
+                        }))
                 {
                     HPX_THROW_EXCEPTION(hpx::bad_parameter,
                         "add_operation::add1d1d",
@@ -182,18 +220,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 if (ops.size() == 2)
                 {
-                    lhs.matrix().array() += rhs.matrix().array();
+                    transform(lhs, rhs,
+                        [](array_segment const& x, const_array_segment const& y)
+                        {
+                            return x + y;
+                        });
                     return primitive_result_type(std::move(lhs));
                 }
 
-                operand_type& first_term = *ops.begin();
-                return primitive_result_type(std::accumulate(
-                    ops.begin() + 1, ops.end(), std::move(first_term),
-                    [](operand_type& result, operand_type const& curr) -> operand_type
-                    {
-                        result.matrix().array() += curr.matrix().array();
-                        return std::move(result);
-                    }));
+                return primitive_result_type(combine_elements(
+                    elementwise_operation::add, std::move(ops)));
             }
 
             primitive_result_type add1d(operands_type && ops) const
@@ -227,38 +263,84 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a matrix only if there are exactly 2 operands");
                 }
 
-                ops[0].matrix().array() += ops[1][0];
+                double const value = ops[1][0];
+                transform(ops[0],
+                    [value](array_segment const& x)
+                    {
+                        return x + value;
+                    });
                 return primitive_result_type(std::move(ops[0]));
             }
 
             primitive_result_type add2d2d(operands_type && ops) const
             {
                 operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
+                operand_type const& rhs = ops[1];
 
                 auto lhs_size = lhs.dimensions();
-                auto rhs_size = rhs.dimensions();
-
-                if (lhs_size != rhs_size)
+                if (std::any_of(ops.begin() + 1, ops.end(),
+                        [&](operand_type const& op)
+                        {
+                            return op.dimensions() != lhs_size;
+                        }))
                 {
                     HPX_THROW_EXCEPTION(hpx::bad_parameter,
                         "add_operation::add2d2d",
                         "the dimensions of the operands do not match");
                 }
 
+                if (std::any_of(ops.begin(), ops.end(),
+                        [](operand_type const& op) { return op.is_sparse(); }))
+                {
+                    return add2d2d_sparse(std::move(ops));
+                }
+
                 if (ops.size() == 2)
                 {
-                    lhs.matrix().array() += rhs.matrix().array();
+                    transform(lhs, rhs,
+                        [](array_segment const& x, const_array_segment const& y)
+                        {
+                            return x + y;
+                        });
                     return primitive_result_type(std::move(lhs));
                 }
 
+                return primitive_result_type(combine_elements(
+                    elementwise_operation::add, std::move(ops)));
+            }
+
+            // at least one of the operands holds sparse data: the sum of sparse
+            // operands stays sparse, adding a dense operand makes it dense
+            primitive_result_type add2d2d_sparse(operands_type && ops) const
+            {
                 operand_type& first_term = *ops.begin();
                 return primitive_result_type(std::accumulate(
                     ops.begin() + 1, ops.end(), std::move(first_term),
                     [](operand_type& result, operand_type const& curr)
                     ->  operand_type
                     {
-                        result.matrix().array() += curr.matrix().array();
+                        if (result.is_sparse())
+                        {
+                            if (curr.is_sparse())
+                            {
+                                result.sparse_matrix() += curr.sparse_matrix();
+                                return std::move(result);
+                            }
+
+                            operand_type const& sparse_term = result;
+                            operand_type::storage_type sum = curr.matrix();
+                            sum += sparse_term.sparse_matrix();
+                            return operand_type(std::move(sum));
+                        }
+
+                        if (curr.is_sparse())
+                        {
+                            result.matrix() += curr.sparse_matrix();
+                        }
+                        else
+                        {
+                            result.matrix().array() += curr.matrix().array();
+                        }
                         return std::move(result);
                     }));
             }
@@ -282,33 +364,113 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 }
             }
 
+            ///////////////////////////////////////////////////////////////////////////
+            primitive_result_type addnd0d(operands_type && ops) const
+            {
+                if (ops.size() != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "add_operation::addnd0d",
+                        "the add_operation primitive can add a single value "
+                            "to an array only if there are exactly 2 operands");
+                }
+
+                double const value = ops[1][0];
+                transform(ops[0],
+                    [value](array_segment const& x)
+                    {
+                        return x + value;
+                    });
+                return primitive_result_type(std::move(ops[0]));
+            }
+
+            primitive_result_type addndnd(operands_type && ops) const
+            {
+                operand_type& lhs = ops[0];
+
+                auto lhs_shape = lhs.shape();
+                for (auto it = ops.begin() + 1; it != ops.end(); ++it)
+                {
+                    if (it->shape() != lhs_shape)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "add_operation::addndnd",
+                            "the dimensions of the operands do not match");
+                    }
+                }
+
+                // all operands are contiguous and have the same shape, thus
+                // their elements can be combined using their 2-dimensional
+                // representation
+                if (ops.size() == 2)
+                {
+                    operand_type const& rhs = ops[1];
+                    transform(lhs, rhs,
+                        [](array_segment const& x, const_array_segment const& y)
+                        {
+                            return x + y;
+                        });
+                    return primitive_result_type(std::move(lhs));
+                }
+
+                return primitive_result_type(combine_elements(
+                    elementwise_operation::add, std::move(ops)));
+            }
+
+            primitive_result_type addnd(operands_type && ops) const
+            {
+                std::size_t lhs_dims = ops[0].num_dimensions();
+                std::size_t rhs_dims = ops[1].num_dimensions();
+
+                if (rhs_dims == 0)
+                {
+                    return addnd0d(std::move(ops));
+                }
+                if (rhs_dims == lhs_dims)
+                {
+                    return addndnd(std::move(ops));
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "add_operation::addnd",
+                    "the operands have incompatible number of dimensions");
+            }
+
         public:
+            primitive_result_type compute(operands_type && ops) const
+            {
+                std::size_t lhs_dims = ops[0].num_dimensions();
+                switch (lhs_dims)
+                {
+                case 0:
+                    return add0d(std::move(ops));
+
+                case 1:
+                    return add1d(std::move(ops));
+
+                case 2:
+                    return add2d(std::move(ops));
+
+                default:
+                    return addnd(std::move(ops));
+                }
+            }
+
             hpx::future<primitive_result_type> eval() const
             {
                 auto this_ = this->shared_from_this();
                 return hpx::dataflow(hpx::util::unwrapping(
-                    [this_](operands_type && ops) -> primitive_result_type
+                    [this_](std::vector<primitive_result_type> && ops)
+                    ->  primitive_result_type
                     {
-                        std::size_t lhs_dims = ops[0].num_dimensions();
-                        switch (lhs_dims)
+                        if (is_typed_operation(typed_operation::add, ops))
                         {
-                        case 0:
-                            return this_->add0d(std::move(ops));
-
-                        case 1:
-                            return this_->add1d(std::move(ops));
-
-                        case 2:
-                            return this_->add2d(std::move(ops));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "add_operation::eval",
-                                "left hand side operand has unsupported "
-                                    "number of dimensions");
+                            return typed_elementwise(typed_operation::add,
+                                std::move(ops), "add_operation::eval");
                         }
+                        return this_->compute(numeric_values(std::move(ops)));
                     }),
-                    detail::map_operands(operands_, numeric_operand)
+                    detail::map_operands(operands_, literal_operand)
                 );
             }
 
@@ -322,4 +484,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         return std::make_shared<detail::add>(operands_)->eval();
     }
+
+    primitive_result_type add_operation::apply(
+        std::vector<ir::node_data<double>>&& ops)
+    {
+        detail::add op{std::vector<primitive_argument_type>{}};
+        return op.compute(std::move(ops));
+    }
 }}}
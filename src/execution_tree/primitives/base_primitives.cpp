@@ -11,7 +11,15 @@
 
 #include <hpx/include/actions.hpp>
 #include <hpx/include/components.hpp>
-
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -27,22 +35,159 @@ HPX_REGISTER_ACTION(base_primitive_type::eval_action,
     phylanx_primitive_eval_action)
 HPX_REGISTER_ACTION(base_primitive_type::store_action,
     phylanx_primitive_store_action)
+HPX_REGISTER_ACTION(base_primitive_type::eval_last_use_action,
+    phylanx_primitive_eval_last_use_action)
 HPX_DEFINE_GET_COMPONENT_TYPE(base_primitive_type)
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree
 {
     ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Evaluating a primitive directly evaluates its operands directly as
+        // well, so the nesting depth of direct evaluations is bounded to
+        // limit the stack space needed for evaluating deep trees. Deeper
+        // primitives are evaluated on a new thread. The depth is counted
+        // per worker thread and restored once a direct evaluation returns.
+        // If an evaluation is suspended and resumed on a different worker,
+        // the counters stay within [0, max_direct_eval_depth], which bounds
+        // the nesting depth nevertheless.
+        constexpr std::size_t const max_direct_eval_depth = 16;
+
+        std::size_t& direct_eval_depth()
+        {
+            static thread_local std::size_t depth = 0;
+            return depth;
+        }
+
+        std::size_t get_direct_eval_depth()
+        {
+            if (hpx::threads::get_self_ptr() == nullptr)
+            {
+                // outside of HPX threads everything is evaluated on a new
+                // thread
+                return max_direct_eval_depth;
+            }
+            return direct_eval_depth();
+        }
+
+        void set_direct_eval_depth(std::size_t depth)
+        {
+            direct_eval_depth() = depth;
+        }
+
+        struct direct_eval_depth_guard
+        {
+            explicit direct_eval_depth_guard(std::size_t depth)
+              : saved_depth_(get_direct_eval_depth())
+            {
+                set_direct_eval_depth(depth);
+            }
+            ~direct_eval_depth_guard()
+            {
+                set_direct_eval_depth(saved_depth_);
+            }
+
+            std::size_t saved_depth_;
+        };
+
+        hpx::future<primitive_result_type> eval_direct(
+            std::shared_ptr<primitives::base_primitive> const& p,
+            std::size_t depth)
+        {
+            try
+            {
+                direct_eval_depth_guard g(depth);
+                return p->eval();
+            }
+            catch (...)
+            {
+                return hpx::make_exceptional_future<primitive_result_type>(
+                    std::current_exception());
+            }
+        }
+    }
+
+    std::shared_ptr<primitives::base_primitive> primitive::local_ptr() const
+    {
+        std::shared_ptr<primitives::base_primitive> p = std::atomic_load(&ptr_);
+        if (!p)
+        {
+            hpx::id_type const& id = this->base_type::get_id();
+            if (hpx::naming::get_locality_id_from_id(id) ==
+                hpx::get_locality_id())
+            {
+                p = hpx::get_ptr<primitives::base_primitive>(
+                    hpx::launch::sync, id);
+                std::atomic_store(&ptr_, p);
+            }
+        }
+        return p;
+    }
+
     hpx::future<primitive_result_type> primitive::eval() const
     {
-        using action_type = primitives::base_primitive::eval_action;
-        return hpx::async(action_type(), this->base_type::get_id());
+        std::shared_ptr<primitives::base_primitive> p = local_ptr();
+        if (!p)
+        {
+            using action_type = primitives::base_primitive::eval_action;
+            return hpx::async(action_type(), this->base_type::get_id());
+        }
+
+        std::size_t const depth = detail::get_direct_eval_depth();
+        if (depth < detail::max_direct_eval_depth)
+        {
+            return detail::eval_direct(p, depth + 1);
+        }
+
+        return hpx::future<primitive_result_type>(hpx::async(
+            [p]() -> hpx::future<primitive_result_type>
+            {
+                return detail::eval_direct(p, 0);
+            }));
+    }
+
+    hpx::future<primitive_result_type> primitive::eval_last_use() const
+    {
+        std::shared_ptr<primitives::base_primitive> p = local_ptr();
+        if (!p)
+        {
+            using action_type =
+                primitives::base_primitive::eval_last_use_action;
+            return hpx::async(action_type(), this->base_type::get_id());
+        }
+
+        try
+        {
+            return p->eval_last_use();
+        }
+        catch (...)
+        {
+            return hpx::make_exceptional_future<primitive_result_type>(
+                std::current_exception());
+        }
     }
 
     hpx::future<void> primitive::store(primitive_result_type const& data)
     {
-        using action_type = primitives::base_primitive::store_action;
-        return hpx::async(action_type(), this->base_type::get_id(), data);
+        std::shared_ptr<primitives::base_primitive> p = local_ptr();
+        if (!p)
+        {
+            using action_type = primitives::base_primitive::store_action;
+            return hpx::async(action_type(), this->base_type::get_id(), data);
+        }
+
+        try
+        {
+            p->store(data);
+            return hpx::make_ready_future();
+        }
+        catch (...)
+        {
+            return hpx::make_exceptional_future<void>(
+                std::current_exception());
+        }
     }
 
     void primitive::store(hpx::launch::sync_policy,
@@ -72,7 +217,16 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return util::get<4>(val);
 
-        case 5: HPX_FALLTHROUGH;    // primitive
+        case 5:     // phylanx::ir::node_data<float>
+            return util::get<5>(val);
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return util::get<6>(val);
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return util::get<7>(val);
+
+        case 8: HPX_FALLTHROUGH;    // primitive
         default:
             break;
         }
@@ -102,6 +256,15 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return util::get<4>(std::move(val));
 
+        case 5:     // phylanx::ir::node_data<float>
+            return util::get<5>(std::move(val));
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return util::get<6>(std::move(val));
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return util::get<7>(std::move(val));
+
         default:
             break;
         }
@@ -124,11 +287,20 @@ namespace phylanx { namespace execution_tree
             return ir::node_data<double>{double(util::get<2>(val))};
 
         case 4:     // phylanx::ir::node_data<double>
-            return util::get<4>(val);
+            return util::get<4>(val).contiguous();
+
+        case 5:     // phylanx::ir::node_data<float>
+            return ir::node_data<double>{util::get<5>(val)};
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return ir::node_data<double>{util::get<6>(val)};
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return ir::node_data<double>{util::get<7>(val)};
 
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
-        case 5: HPX_FALLTHROUGH;    // primitive
+        case 8: HPX_FALLTHROUGH;    // primitive
         default:
             break;
         }
@@ -150,7 +322,16 @@ namespace phylanx { namespace execution_tree
             return ir::node_data<double>{double(util::get<2>(val))};
 
         case 4:     // phylanx::ir::node_data<double>
-            return util::get<4>(std::move(val));
+            return util::get<4>(std::move(val)).contiguous();
+
+        case 5:     // phylanx::ir::node_data<float>
+            return ir::node_data<double>{util::get<5>(val)};
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return ir::node_data<double>{util::get<6>(val)};
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return ir::node_data<double>{util::get<7>(val)};
 
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
@@ -177,9 +358,18 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return bool(util::get<4>(val));
 
+        case 5:     // phylanx::ir::node_data<float>
+            return bool(util::get<5>(val));
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return bool(util::get<6>(val));
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return bool(util::get<7>(val));
+
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
-        case 5: HPX_FALLTHROUGH;    // primitive
+        case 8: HPX_FALLTHROUGH;    // primitive
         default:
             break;
         }
@@ -202,6 +392,15 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return bool(util::get<4>(val));
 
+        case 5:     // phylanx::ir::node_data<float>
+            return bool(util::get<5>(val));
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return bool(util::get<6>(val));
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return bool(util::get<7>(val));
+
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
         default:
@@ -281,6 +480,22 @@ namespace phylanx { namespace execution_tree
         return hpx::make_ready_future(extract_boolean_value(val));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::atomic<std::uint64_t> store_generation(0);
+    }
+
+    std::uint64_t get_store_generation()
+    {
+        return detail::store_generation.load(std::memory_order_acquire);
+    }
+
+    void increment_store_generation()
+    {
+        detail::store_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type to_primitive_value_type(primitive_result_type&& val)
     {
@@ -301,6 +516,15 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return util::get<4>(std::move(val));
 
+        case 5:     // phylanx::ir::node_data<float>
+            return util::get<5>(std::move(val));
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return util::get<6>(std::move(val));
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return util::get<7>(std::move(val));
+
         default:
             break;
         }
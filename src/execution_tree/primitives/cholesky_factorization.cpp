@@ -0,0 +1,143 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/cholesky_factorization.hpp>
+#include <phylanx/execution_tree/primitives/detail/factorization_cache.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/eigen.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::cholesky_factorization>
+    cholesky_factorization_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    cholesky_factorization_type, phylanx_cholesky_factorization_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(cholesky_factorization_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const cholesky_factorization::match_data =
+    {
+        hpx::util::make_tuple("cholesky", "cholesky(_1)",
+            &create<cholesky_factorization>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    cholesky_factorization::cholesky_factorization(
+            std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+    {
+        if (operands_.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "cholesky_factorization::cholesky_factorization",
+                "the cholesky_factorization primitive requires exactly one "
+                    "operand");
+        }
+
+        if (!valid(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "cholesky_factorization::cholesky_factorization",
+                "the cholesky_factorization primitive requires that the "
+                    "argument given by the operands array is valid");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct cholesky : std::enable_shared_from_this<cholesky>
+        {
+            cholesky(std::vector<primitive_argument_type> const& operands)
+              : operands_(operands)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        std::size_t dims = ops[0].num_dimensions();
+                        switch (dims)
+                        {
+                        case 0:
+                            return this_->cholesky0d(std::move(ops));
+
+                        case 2:
+                            return this_->cholesky2d(std::move(ops));
+
+                        default:
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "cholesky_factorization::eval",
+                                "left hand side operand has unsupported "
+                                    "number of dimensions");
+                        }
+                    }),
+                    detail::map_operands(operands_, numeric_operand)
+                );
+            }
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+            using matrix_type = operand_type::storage_type;
+
+            primitive_result_type cholesky0d(operands_type && ops) const
+            {
+                double const value = ops[0][0];
+                if (!(value > 0.0))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "cholesky_factorization::cholesky0d",
+                        "the value is not positive");
+                }
+                return operand_type(std::sqrt(value));
+            }
+
+            primitive_result_type cholesky2d(operands_type && ops) const
+            {
+                operand_type const& op = ops[0];
+
+                auto dims = op.dimensions();
+                if (dims[0] != dims[1])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "cholesky_factorization::cholesky2d",
+                        "the cholesky_factorization primitive requires a "
+                            "quadratic matrix");
+                }
+
+                // the decomposition is shared with solve
+                matrix_type result =
+                    cached_cholesky(operands_[0], op)->matrixL();
+                return operand_type(std::move(result));
+            }
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+        };
+    }
+
+    hpx::future<primitive_result_type> cholesky_factorization::eval() const
+    {
+        return std::make_shared<detail::cholesky>(operands_)->eval();
+    }
+}}}
@@ -0,0 +1,91 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/common_subexpression.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::common_subexpression>
+    common_subexpression_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(common_subexpression_type,
+    phylanx_common_subexpression_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(common_subexpression_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    common_subexpression::common_subexpression(
+            std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+      , generation_(0)
+    {
+        if (operands_.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "common_subexpression::common_subexpression",
+                "the common_subexpression primitive requires exactly one "
+                    "operand");
+        }
+
+        if (!valid(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "common_subexpression::common_subexpression",
+                "the common_subexpression primitive requires that the "
+                    "argument given by the operands array is valid");
+        }
+    }
+
+    hpx::future<primitive_result_type> common_subexpression::eval() const
+    {
+        std::uint64_t const generation = get_store_generation();
+
+        hpx::shared_future<primitive_result_type> value;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (value_.valid() && generation_ == generation)
+            {
+                value = value_;
+            }
+        }
+
+        if (!value.valid())
+        {
+            // the operand is evaluated without holding the lock as it might
+            // be evaluated directly
+            value = literal_operand(operands_[0]).share();
+
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!value_.valid() || generation_ <= generation)
+            {
+                value_ = value;
+                generation_ = generation;
+            }
+        }
+
+        // the shared value is copied, node_data copies its array on the
+        // first modification
+        if (value.is_ready() && value.has_value())
+        {
+            return hpx::make_ready_future(value.get());
+        }
+        return value.then(
+            [](hpx::shared_future<primitive_result_type> && f)
+            {
+                return f.get();
+            });
+    }
+}}}
@@ -0,0 +1,104 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/conjugate_gradient.hpp>
+#include <phylanx/execution_tree/primitives/detail/iterative_solvers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/eigen.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::conjugate_gradient>
+    conjugate_gradient_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    conjugate_gradient_type, phylanx_conjugate_gradient_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(conjugate_gradient_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const conjugate_gradient::match_data =
+    {
+        hpx::util::make_tuple("cg", "cg(_1, _2)",
+            &create<conjugate_gradient>),
+        hpx::util::make_tuple("cg", "cg(_1, _2, _3)",
+            &create<conjugate_gradient>),
+        hpx::util::make_tuple("cg", "cg(_1, _2, _3, _4)",
+            &create<conjugate_gradient>),
+        hpx::util::make_tuple("cg", "cg(_1, _2, _3, _4, _5)",
+            &create<conjugate_gradient>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    conjugate_gradient::conjugate_gradient(
+            std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+    {
+        if (operands_.size() < 2 || operands_.size() > 5)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "conjugate_gradient::conjugate_gradient",
+                "the conjugate_gradient primitive requires between two and "
+                    "five operands");
+        }
+
+        for (auto const& operand : operands_)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "conjugate_gradient::conjugate_gradient",
+                    "the conjugate_gradient primitive requires that the "
+                        "arguments given by the operands array are valid");
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct cg_solver : std::enable_shared_from_this<cg_solver>
+        {
+            cg_solver(std::vector<primitive_argument_type> const& operands)
+              : operands_(operands)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        return iterative_solve(
+                            iterative_method::cg, std::move(ops));
+                    }),
+                    detail::map_operands(operands_, numeric_operand)
+                );
+            }
+
+        protected:
+            using operands_type = std::vector<ir::node_data<double>>;
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+        };
+    }
+
+    hpx::future<primitive_result_type> conjugate_gradient::eval() const
+    {
+        return std::make_shared<detail::cg_solver>(operands_)->eval();
+    }
+}}}
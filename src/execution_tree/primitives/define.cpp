@@ -103,7 +103,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         // instantiate the new function
         auto result = execution_tree::detail::generate_tree(it->second.second,
-            execution_tree::detail::generate_patterns(get_all_known_patterns()),
+            *execution_tree::detail::get_all_known_expression_patterns(),
             variables, functions);
 
         return primitive_operand(result);
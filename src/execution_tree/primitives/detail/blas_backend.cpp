@@ -0,0 +1,190 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/blas_backend.hpp>
+#include <phylanx/execution_tree/primitives/detail/matrix_product.hpp>
+
+#include <vector>
+
+#if defined(PHYLANX_HAVE_BLAS)
+#include <cblas.h>
+#include <lapacke.h>
+
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <utility>
+#endif
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+#if defined(PHYLANX_HAVE_BLAS)
+    ///////////////////////////////////////////////////////////////////////////
+    namespace blas
+    {
+        // The BLAS library is called from HPX worker threads, running its
+        // own threads as well would oversubscribe the cores. Large products
+        // are split into tiles computed concurrently by HPX instead (see
+        // matrix_product).
+        void init()
+        {
+#if defined(PHYLANX_HAVE_OPENBLAS)
+            static std::once_flag flag;
+            std::call_once(flag, []()
+            {
+                openblas_set_num_threads(1);
+            });
+#endif
+        }
+
+        // the extents have to be representable by the integer types used
+        // by the libraries
+        bool fits(std::ptrdiff_t extent)
+        {
+            return extent > 0 &&
+                extent <= std::ptrdiff_t((std::numeric_limits<int>::max)());
+        }
+
+        bool fits(const_matrix_ref const& m)
+        {
+            return fits(m.rows()) && fits(m.cols()) && fits(m.outerStride());
+        }
+
+        // copy the operand and compute its LU decomposition in place
+        bool lu_decompose(const_matrix_ref const& op, matrix_type& lu,
+            std::vector<lapack_int>& pivots)
+        {
+            lapack_int const n = static_cast<lapack_int>(op.rows());
+
+            lu = op;
+            pivots.resize(static_cast<std::size_t>(n));
+            return LAPACKE_dgetrf(LAPACK_COL_MAJOR, n, n, lu.data(), n,
+                pivots.data()) == 0;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool use_blas(double flops)
+    {
+        return flops >= double(PHYLANX_BLAS_THRESHOLD);
+    }
+
+    bool blas_matrix_product(const_matrix_ref const& lhs,
+        const_matrix_ref const& rhs, matrix_ref result)
+    {
+        if (!blas::fits(lhs) || !blas::fits(rhs) ||
+            !blas::fits(result.outerStride()) ||
+            !use_blas(double(lhs.rows()) * double(lhs.cols()) *
+                double(rhs.cols())))
+        {
+            return false;
+        }
+
+        blas::init();
+
+        int const rows = static_cast<int>(lhs.rows());
+        int const inner = static_cast<int>(lhs.cols());
+        int const cols = static_cast<int>(rhs.cols());
+
+        if (cols == 1)
+        {
+            cblas_dgemv(CblasColMajor, CblasNoTrans, rows, inner, 1.0,
+                lhs.data(), static_cast<int>(lhs.outerStride()), rhs.data(),
+                1, 0.0, result.data(), 1);
+        }
+        else
+        {
+            cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, rows, cols,
+                inner, 1.0, lhs.data(), static_cast<int>(lhs.outerStride()),
+                rhs.data(), static_cast<int>(rhs.outerStride()), 0.0,
+                result.data(), static_cast<int>(result.outerStride()));
+        }
+        return true;
+    }
+
+    bool lapack_inverse(const_matrix_ref const& op, matrix_type& result)
+    {
+        double const n = double(op.rows());
+        if (op.rows() != op.cols() || !blas::fits(op) || !use_blas(n * n * n))
+        {
+            return false;
+        }
+
+        blas::init();
+
+        matrix_type lu;
+        std::vector<lapack_int> pivots;
+        if (!blas::lu_decompose(op, lu, pivots))
+        {
+            return false;
+        }
+
+        lapack_int const rows = static_cast<lapack_int>(op.rows());
+        if (LAPACKE_dgetri(LAPACK_COL_MAJOR, rows, lu.data(), rows,
+                pivots.data()) != 0)
+        {
+            return false;
+        }
+
+        result = std::move(lu);
+        return true;
+    }
+
+    bool lapack_lu(const_matrix_ref const& op, matrix_type& lu,
+        std::vector<int>& pivots)
+    {
+        double const n = double(op.rows());
+        if (op.rows() != op.cols() || !blas::fits(op) || !use_blas(n * n * n))
+        {
+            return false;
+        }
+
+        blas::init();
+
+        // singular matrices are factorized as well (dgetrf reports a zero
+        // pivot by returning a positive value)
+        matrix_type result = op;
+        std::vector<lapack_int> ipiv(static_cast<std::size_t>(op.rows()));
+        lapack_int const rows = static_cast<lapack_int>(op.rows());
+        if (LAPACKE_dgetrf(LAPACK_COL_MAJOR, rows, rows, result.data(), rows,
+                ipiv.data()) < 0)
+        {
+            return false;
+        }
+
+        lu = std::move(result);
+        pivots.resize(ipiv.size());
+        for (std::size_t i = 0; i != ipiv.size(); ++i)
+        {
+            pivots[i] = static_cast<int>(ipiv[i] - 1);
+        }
+        return true;
+    }
+#else
+    ///////////////////////////////////////////////////////////////////////////
+    bool use_blas(double)
+    {
+        return false;
+    }
+
+    bool blas_matrix_product(
+        const_matrix_ref const&, const_matrix_ref const&, matrix_ref)
+    {
+        return false;
+    }
+
+    bool lapack_inverse(const_matrix_ref const&, matrix_type&)
+    {
+        return false;
+    }
+
+    bool lapack_lu(const_matrix_ref const&, matrix_type&, std::vector<int>&)
+    {
+        return false;
+    }
+#endif
+}}}}
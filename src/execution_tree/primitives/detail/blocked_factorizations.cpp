@@ -0,0 +1,356 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/blocked_factorizations.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        using matrix_block = Eigen::Block<matrix_type>;
+
+        std::ptrdiff_t const block_size = PHYLANX_FACTORIZATION_BLOCK_SIZE;
+
+        // Schedule the tasks of a right-looking blocked factorization of a
+        // matrix with the given number of columns. panel(first, count)
+        // factorizes the columns [first, first + count), update(first,
+        // count, col, cols) applies the transformations computed by that
+        // panel to the columns [col, col + cols). Every block of columns has
+        // its own chain of tasks, a panel depends on the last update of its
+        // columns only.
+        template <typename Panel, typename Update>
+        void schedule_factorization(std::ptrdiff_t steps, std::ptrdiff_t cols,
+            Panel const& panel, Update const& update)
+        {
+            std::ptrdiff_t const blocks = (cols + block_size - 1) / block_size;
+
+            std::vector<hpx::shared_future<void>> columns(
+                blocks, hpx::make_ready_future());
+
+            for (std::ptrdiff_t k = 0; k * block_size < steps; ++k)
+            {
+                std::ptrdiff_t const first = k * block_size;
+                std::ptrdiff_t const count =
+                    (std::min)(block_size, steps - first);
+                std::ptrdiff_t const width =
+                    (std::min)(block_size, cols - first);
+
+                hpx::shared_future<void> factorized = hpx::dataflow(
+                    [&panel, &update, first, count, width](
+                        hpx::shared_future<void> previous)
+                    {
+                        previous.get();
+                        panel(first, count);
+
+                        // the last panel of a wide matrix does not cover all
+                        // of its columns
+                        if (count != width)
+                        {
+                            update(first, count, first + count,
+                                width - count);
+                        }
+                    },
+                    columns[k]);
+                columns[k] = factorized;
+
+                for (std::ptrdiff_t j = k + 1; j != blocks; ++j)
+                {
+                    std::ptrdiff_t const col = j * block_size;
+                    std::ptrdiff_t const n = (std::min)(block_size, cols - col);
+
+                    columns[j] = hpx::dataflow(
+                        [&update, first, count, col, n](
+                            hpx::shared_future<void> panel_done,
+                            hpx::shared_future<void> previous)
+                        {
+                            panel_done.get();
+                            previous.get();
+                            update(first, count, col, n);
+                        },
+                        factorized, columns[j]);
+                }
+            }
+
+            // rethrow the first exception, if any
+            hpx::wait_all(columns);
+            for (auto const& f : columns)
+            {
+                f.get();
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Unblocked LU decomposition (with partial pivoting) of the columns
+        // [first, first + count) from row first downwards.
+        void lu_panel(matrix_type& a, std::vector<std::ptrdiff_t>& pivots,
+            std::ptrdiff_t first, std::ptrdiff_t count)
+        {
+            std::ptrdiff_t const rows = a.rows();
+            std::ptrdiff_t const last = first + count;
+
+            for (std::ptrdiff_t i = first; i != last; ++i)
+            {
+                std::ptrdiff_t p = 0;
+                a.col(i).tail(rows - i).cwiseAbs().maxCoeff(&p);
+                p += i;
+
+                pivots[i] = p;
+                if (p != i)
+                {
+                    a.row(i).segment(first, count).swap(
+                        a.row(p).segment(first, count));
+                }
+
+                // a zero pivot means that the whole column is zero already
+                double const pivot = a(i, i);
+                if (pivot != 0.0)
+                {
+                    a.col(i).tail(rows - i - 1) /= pivot;
+                }
+
+                a.block(i + 1, i + 1, rows - i - 1, last - i - 1).noalias() -=
+                    a.col(i).tail(rows - i - 1) *
+                    a.row(i).segment(i + 1, last - i - 1);
+            }
+        }
+
+        // Apply the row interchanges and the elimination steps of the panel
+        // [first, first + count) to the columns [col, col + cols).
+        void lu_update(matrix_type& a,
+            std::vector<std::ptrdiff_t> const& pivots, std::ptrdiff_t first,
+            std::ptrdiff_t count, std::ptrdiff_t col, std::ptrdiff_t cols)
+        {
+            std::ptrdiff_t const below = a.rows() - first - count;
+
+            for (std::ptrdiff_t i = first; i != first + count; ++i)
+            {
+                if (pivots[i] != i)
+                {
+                    a.row(i).segment(col, cols).swap(
+                        a.row(pivots[i]).segment(col, cols));
+                }
+            }
+
+            matrix_block u = a.block(first, col, count, cols);
+            a.block(first, first, count, count)
+                .triangularView<Eigen::UnitLower>()
+                .solveInPlace(u);
+
+            if (below != 0)
+            {
+                a.block(first + count, col, below, cols).noalias() -=
+                    a.block(first + count, first, below, count) * u;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The Householder reflections of a panel combined into the block
+        // reflector H = I - V * T * V^T.
+        struct block_reflector
+        {
+            matrix_type v;
+            matrix_type t;
+        };
+
+        block_reflector make_block_reflector(matrix_type const& a,
+            std::vector<double> const& tau, std::ptrdiff_t first,
+            std::ptrdiff_t count)
+        {
+            block_reflector h;
+            h.v = a.block(first, first, a.rows() - first, count)
+                      .triangularView<Eigen::UnitLower>();
+
+            h.t = matrix_type::Zero(count, count);
+            for (std::ptrdiff_t i = 0; i != count; ++i)
+            {
+                double const tau_i = tau[first + i];
+
+                h.t(i, i) = tau_i;
+                if (i != 0)
+                {
+                    Eigen::VectorXd w =
+                        -tau_i * (h.v.leftCols(i).transpose() * h.v.col(i));
+                    h.t.col(i).head(i).noalias() =
+                        h.t.topLeftCorner(i, i)
+                            .triangularView<Eigen::Upper>() * w;
+                }
+            }
+            return h;
+        }
+
+        // c = H * c (or H^T * c if transposed is true)
+        void apply_block_reflector(block_reflector const& h,
+            matrix_block c, bool transposed)
+        {
+            matrix_type w = h.v.transpose() * c;
+            if (transposed)
+            {
+                w = h.t.transpose().triangularView<Eigen::Lower>() * w;
+            }
+            else
+            {
+                w = h.t.triangularView<Eigen::Upper>() * w;
+            }
+            c.noalias() -= h.v * w;
+        }
+
+        // Unblocked Householder QR decomposition of the columns [first,
+        // first + count) from row first downwards.
+        void qr_panel(matrix_type& a, std::vector<double>& tau,
+            std::ptrdiff_t first, std::ptrdiff_t count)
+        {
+            std::ptrdiff_t const rows = a.rows();
+            std::ptrdiff_t const last = first + count;
+
+            Eigen::VectorXd workspace(count);
+            for (std::ptrdiff_t i = first; i != last; ++i)
+            {
+                double beta = 0.0;
+                a.col(i).tail(rows - i).makeHouseholderInPlace(tau[i], beta);
+                a(i, i) = beta;
+
+                if (i + 1 != last)
+                {
+                    a.block(i, i + 1, rows - i, last - i - 1)
+                        .applyHouseholderOnTheLeft(
+                            a.col(i).tail(rows - i - 1), tau[i],
+                            workspace.data());
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void blocked_lu(matrix_type& a, std::vector<std::ptrdiff_t>& pivots)
+    {
+        std::ptrdiff_t const steps = (std::min)(a.rows(), a.cols());
+        pivots.resize(steps);
+
+        schedule_factorization(steps, a.cols(),
+            [&](std::ptrdiff_t first, std::ptrdiff_t count)
+            {
+                lu_panel(a, pivots, first, count);
+            },
+            [&](std::ptrdiff_t first, std::ptrdiff_t count, std::ptrdiff_t col,
+                std::ptrdiff_t cols)
+            {
+                lu_update(a, pivots, first, count, col, cols);
+            });
+
+        // the row interchanges of each panel still have to be applied to the
+        // parts of L left of it
+        std::ptrdiff_t const panels = (steps + block_size - 1) / block_size;
+        if (panels > 1)
+        {
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::ptrdiff_t(0), panels - 1,
+                [&](std::ptrdiff_t k)
+                {
+                    std::ptrdiff_t const col = k * block_size;
+                    for (std::ptrdiff_t i = col + block_size; i != steps; ++i)
+                    {
+                        if (pivots[i] != i)
+                        {
+                            a.row(i).segment(col, block_size).swap(
+                                a.row(pivots[i]).segment(col, block_size));
+                        }
+                    }
+                });
+        }
+    }
+
+    matrix_type lu_permutation(
+        std::vector<std::ptrdiff_t> const& pivots, std::ptrdiff_t rows)
+    {
+        std::vector<std::ptrdiff_t> permutation(rows);
+        for (std::ptrdiff_t i = 0; i != rows; ++i)
+        {
+            permutation[i] = i;
+        }
+        for (std::size_t i = 0; i != pivots.size(); ++i)
+        {
+            std::swap(permutation[i], permutation[pivots[i]]);
+        }
+
+        // row i of P * A is row permutation[i] of A
+        matrix_type result = matrix_type::Zero(rows, rows);
+        for (std::ptrdiff_t i = 0; i != rows; ++i)
+        {
+            result(i, permutation[i]) = 1.0;
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void blocked_qr(matrix_type& a, std::vector<double>& tau)
+    {
+        std::ptrdiff_t const steps = (std::min)(a.rows(), a.cols());
+        tau.resize(steps);
+
+        // the block reflectors are written by the panel tasks before any of
+        // the dependent updates read them
+        std::vector<block_reflector> reflectors(
+            (steps + block_size - 1) / block_size);
+
+        schedule_factorization(steps, a.cols(),
+            [&](std::ptrdiff_t first, std::ptrdiff_t count)
+            {
+                qr_panel(a, tau, first, count);
+                reflectors[first / block_size] =
+                    make_block_reflector(a, tau, first, count);
+            },
+            [&](std::ptrdiff_t first, std::ptrdiff_t count, std::ptrdiff_t col,
+                std::ptrdiff_t cols)
+            {
+                apply_block_reflector(reflectors[first / block_size],
+                    a.block(first, col, a.rows() - first, cols), true);
+            });
+    }
+
+    matrix_type qr_thin_q(matrix_type const& a, std::vector<double> const& tau)
+    {
+        std::ptrdiff_t const rows = a.rows();
+        std::ptrdiff_t const steps = tau.size();
+
+        // Q = H_0 * H_1 * ... * I, the reflections are applied last to first
+        // as each of them leaves the columns left of it unchanged
+        matrix_type q = matrix_type::Identity(rows, steps);
+        for (std::ptrdiff_t k = (steps - 1) / block_size; k >= 0; --k)
+        {
+            std::ptrdiff_t const first = k * block_size;
+            std::ptrdiff_t const count = (std::min)(block_size, steps - first);
+
+            block_reflector const h =
+                make_block_reflector(a, tau, first, count);
+
+            std::ptrdiff_t const blocks =
+                (steps - first + block_size - 1) / block_size;
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::ptrdiff_t(0), blocks,
+                [&](std::ptrdiff_t j)
+                {
+                    std::ptrdiff_t const col = first + j * block_size;
+                    apply_block_reflector(h,
+                        q.block(first, col, rows - first,
+                            (std::min)(block_size, steps - col)),
+                        false);
+                });
+        }
+        return q;
+    }
+}}}}
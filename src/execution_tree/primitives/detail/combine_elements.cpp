@@ -0,0 +1,193 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/combine_elements.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    using operand_type = ir::node_data<double>;
+    using operands_type = std::vector<operand_type>;
+
+    // number of elements processed at once, the block of the result stays in
+    // the L1 cache while all operands are combined with it (the chunks of
+    // large arrays processed by separate tasks consist of many blocks)
+    constexpr std::ptrdiff_t combine_block_size = 1024;
+
+    // sums and differences of at least this many operands are reduced in
+    // parallel, each task combines at most reduction_group_size operands
+    constexpr std::size_t parallel_reduction_threshold = 16;
+    constexpr std::size_t reduction_group_size = 8;
+
+    // minimal number of elements of the operands of a parallel reduction
+    constexpr std::ptrdiff_t parallel_reduction_min_size = 4096;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // out[i] = in[0][i] op in[1][i] op ... op in[n - 1][i], out may be equal
+    // to in[0]
+    template <typename F>
+    void combine(double* out, std::vector<double const*> const& in,
+        std::ptrdiff_t size, F f)
+    {
+        for_each_chunk(size,
+            [&](std::ptrdiff_t chunk_first, std::ptrdiff_t chunk_size)
+            {
+                std::ptrdiff_t const last = chunk_first + chunk_size;
+                for (std::ptrdiff_t first = chunk_first; first < last;
+                     first += combine_block_size)
+                {
+                    std::ptrdiff_t const count =
+                        (std::min)(combine_block_size, last - first);
+
+                    double* block = out + first;
+                    double const* lhs = in[0] + first;
+                    double const* rhs = in[1] + first;
+                    for (std::ptrdiff_t i = 0; i != count; ++i)
+                    {
+                        block[i] = f(lhs[i], rhs[i]);
+                    }
+
+                    for (std::size_t k = 2; k != in.size(); ++k)
+                    {
+                        rhs = in[k] + first;
+                        for (std::ptrdiff_t i = 0; i != count; ++i)
+                        {
+                            block[i] = f(block[i], rhs[i]);
+                        }
+                    }
+                }
+            });
+    }
+
+    void combine(elementwise_operation op, double* out,
+        std::vector<double const*> const& in, std::ptrdiff_t size)
+    {
+        switch (op)
+        {
+        case elementwise_operation::add:
+            combine(out, in, size,
+                [](double lhs, double rhs) { return lhs + rhs; });
+            break;
+
+        case elementwise_operation::sub:
+            combine(out, in, size,
+                [](double lhs, double rhs) { return lhs - rhs; });
+            break;
+
+        case elementwise_operation::div:
+            combine(out, in, size,
+                [](double lhs, double rhs) { return lhs / rhs; });
+            break;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Sum the operands [first, last) in a tree of tasks, the leaves of the
+    // tree sum up to reduction_group_size operands in a single pass.
+    hpx::future<operand_type> reduce_sum(
+        operands_type& ops, std::size_t first, std::size_t last)
+    {
+        if (last - first > reduction_group_size)
+        {
+            std::size_t const middle = first + (last - first) / 2;
+            return hpx::dataflow(hpx::util::unwrapping(
+                [](operand_type&& lhs, operand_type&& rhs) -> operand_type
+                {
+                    operand_type const& crhs = rhs;
+                    double* out = lhs.data();
+                    combine(elementwise_operation::add, out,
+                        std::vector<double const*>{out, crhs.data()},
+                        std::ptrdiff_t(lhs.size()));
+                    return std::move(lhs);
+                }),
+                reduce_sum(ops, first, middle),
+                reduce_sum(ops, middle, last));
+        }
+
+        return hpx::async(
+            [&ops, first, last]() -> operand_type
+            {
+                std::vector<double const*> in;
+                in.reserve(last - first);
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    operand_type const& op = ops[i];
+                    in.push_back(op.data());
+                }
+
+                // the sum is computed in place of the first operand if its
+                // data isn't referenced anywhere else
+                operand_type& lhs = ops[first];
+                operand_type result;
+                if (!lhs.is_shared() && !lhs.is_view())
+                {
+                    result = std::move(lhs);
+                }
+                else
+                {
+                    result = operand_type(lhs.dimensions());
+                }
+
+                if (in.size() == 1)
+                {
+                    std::copy(in[0], in[0] + result.size(), result.data());
+                }
+                else
+                {
+                    combine(elementwise_operation::add, result.data(), in,
+                        std::ptrdiff_t(result.size()));
+                }
+                return result;
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    operand_type combine_elements(
+        elementwise_operation op, operands_type&& ops)
+    {
+        operand_type& lhs = ops[0];
+        std::ptrdiff_t const size = std::ptrdiff_t(lhs.size());
+
+        if (op != elementwise_operation::div &&
+            ops.size() > parallel_reduction_threshold &&
+            size >= parallel_reduction_min_size)
+        {
+            // lhs + (ops[1] + ... + ops[n - 1]), respectively
+            // lhs - (ops[1] + ... + ops[n - 1])
+            operand_type sum = reduce_sum(ops, 1, ops.size()).get();
+
+            operand_type const& csum = sum;
+            double* out = lhs.data();
+            combine(op, out, std::vector<double const*>{out, csum.data()},
+                size);
+            return std::move(lhs);
+        }
+
+        // acquire the data of all other operands before the first operand
+        // makes its data unique
+        std::vector<double const*> in(ops.size());
+        for (std::size_t i = 1; i != ops.size(); ++i)
+        {
+            operand_type const& curr = ops[i];
+            in[i] = curr.data();
+        }
+
+        double* out = lhs.data();
+        in[0] = out;
+        combine(op, out, in, size);
+        return std::move(lhs);
+    }
+}}}}
@@ -0,0 +1,140 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/counter_based_random.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    philox_counter philox4x32(philox_counter counter, philox_key key)
+    {
+        std::uint64_t const multiplier0 = 0xD2511F53;
+        std::uint64_t const multiplier1 = 0xCD9E8D57;
+        std::uint32_t const weyl0 = 0x9E3779B9;
+        std::uint32_t const weyl1 = 0xBB67AE85;
+
+        for (int round = 0; round != 10; ++round)
+        {
+            if (round != 0)
+            {
+                key[0] += weyl0;
+                key[1] += weyl1;
+            }
+
+            std::uint64_t const product0 = multiplier0 * counter[0];
+            std::uint64_t const product1 = multiplier1 * counter[2];
+
+            counter = philox_counter{{
+                std::uint32_t(product1 >> 32) ^ counter[1] ^ key[0],
+                std::uint32_t(product1),
+                std::uint32_t(product0 >> 32) ^ counter[3] ^ key[1],
+                std::uint32_t(product0)
+            }};
+        }
+        return counter;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // a double in [0, 1) from 53 of the 64 given bits
+        double to_unit_interval(std::uint32_t high, std::uint32_t low)
+        {
+            std::uint64_t const bits =
+                ((std::uint64_t(high) << 32) | low) >> 11;
+            return double(bits) * (1.0 / 9007199254740992.0);
+        }
+
+        // Every block of 128 random bits produces two consecutive elements,
+        // element i is taken from block i / 2.
+        void generate_pair(double* pair, std::uint64_t block,
+            random_distribution distribution, philox_key const& key,
+            std::uint64_t stream, double probability)
+        {
+            philox_counter const bits = philox4x32(
+                philox_counter{{std::uint32_t(block),
+                    std::uint32_t(block >> 32), std::uint32_t(stream),
+                    std::uint32_t(stream >> 32)}},
+                key);
+
+            double const u0 = to_unit_interval(bits[0], bits[1]);
+            double const u1 = to_unit_interval(bits[2], bits[3]);
+
+            switch (distribution)
+            {
+            case random_distribution::uniform:
+                pair[0] = 2.0 * u0 - 1.0;
+                pair[1] = 2.0 * u1 - 1.0;
+                break;
+
+            case random_distribution::normal:
+                {
+                    // Box-Muller transform, 1 - u0 is in (0, 1]
+                    double const radius = std::sqrt(-2.0 * std::log(1.0 - u0));
+                    double const angle = 6.283185307179586 * u1;
+                    pair[0] = radius * std::cos(angle);
+                    pair[1] = radius * std::sin(angle);
+                }
+                break;
+
+            case random_distribution::bernoulli:
+                pair[0] = u0 < probability ? 1.0 : 0.0;
+                pair[1] = u1 < probability ? 1.0 : 0.0;
+                break;
+            }
+        }
+    }
+
+    void fill_random(double* data, std::ptrdiff_t size,
+        random_distribution distribution, std::uint64_t seed,
+        std::uint64_t stream, double probability)
+    {
+        philox_key const key{{std::uint32_t(seed), std::uint32_t(seed >> 32)}};
+
+        for_each_chunk(size,
+            [&](std::ptrdiff_t first, std::ptrdiff_t count)
+            {
+                std::ptrdiff_t const last = first + count;
+
+                double pair[2];
+                for (std::ptrdiff_t i = first; i < last; i += 2)
+                {
+                    // a chunk may start or end in the middle of a pair
+                    std::ptrdiff_t const element = i - (i % 2);
+                    generate_pair(pair, std::uint64_t(element / 2),
+                        distribution, key, stream, probability);
+
+                    if (element == i)
+                    {
+                        data[i] = pair[0];
+                        if (i + 1 != last)
+                        {
+                            data[i + 1] = pair[1];
+                        }
+                    }
+                    else
+                    {
+                        data[i] = pair[1];
+                        --i;
+                    }
+                }
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint64_t next_random_stream()
+    {
+        static std::atomic<std::uint64_t> stream(0);
+        return stream++;
+    }
+}}}}
@@ -0,0 +1,275 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/detail/blas_backend.hpp>
+#include <phylanx/execution_tree/primitives/detail/factorization_cache.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/naming.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <Eigen/Dense>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    lu_type::lu_type(Eigen::Ref<matrix_type const> const& matrix)
+    {
+        std::vector<int> pivots;
+        if (lapack_lu(matrix, lu_, pivots))
+        {
+            // LAPACK interchanges the rows one after the other
+            Eigen::Transpositions<Eigen::Dynamic, Eigen::Dynamic, int>
+                transpositions(std::ptrdiff_t(pivots.size()));
+            for (std::size_t i = 0; i != pivots.size(); ++i)
+            {
+                transpositions.coeffRef(std::ptrdiff_t(i)) = pivots[i];
+            }
+            permutation_ = transpositions;
+            return;
+        }
+
+        Eigen::PartialPivLU<matrix_type> lu(matrix);
+        lu_ = lu.matrixLU();
+        permutation_ = lu.permutationP();
+    }
+
+    double lu_type::determinant() const
+    {
+        return double(permutation_.determinant()) * lu_.diagonal().prod();
+    }
+
+    bool lu_type::is_singular() const
+    {
+        if (lu_.size() == 0)
+        {
+            return false;
+        }
+
+        auto const pivots = lu_.diagonal().cwiseAbs();
+        return pivots.minCoeff() <=
+            std::numeric_limits<double>::epsilon() * pivots.maxCoeff();
+    }
+
+    lu_type::matrix_type lu_type::solve(
+        Eigen::Ref<matrix_type const> const& rhs) const
+    {
+        // this is what Eigen::PartialPivLU::solve does, a single right hand
+        // side is solved for as a vector (as Eigen does for vectors)
+        if (rhs.cols() == 1)
+        {
+            Eigen::VectorXd result = permutation_ * rhs.col(0);
+            lu_.triangularView<Eigen::UnitLower>().solveInPlace(result);
+            lu_.triangularView<Eigen::Upper>().solveInPlace(result);
+            return result;
+        }
+
+        matrix_type result = permutation_ * rhs;
+        lu_.triangularView<Eigen::UnitLower>().solveInPlace(result);
+        lu_.triangularView<Eigen::Upper>().solveInPlace(result);
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // The decompositions of the array last produced by a primitive. The
+        // entry refers to the array by its identity only, it doesn't keep
+        // the array alive (which would force any modification of it to copy
+        // the elements).
+        struct factorizations
+        {
+            explicit factorizations(ir::node_data<double> const& value)
+              : identity_(value.identity())
+              , dimensions_(value.dimensions())
+              , last_used_(0)
+            {}
+
+            bool is_same_array(ir::node_data<double> const& value) const
+            {
+                return identity_ == value.identity() &&
+                    dimensions_ == value.dimensions();
+            }
+
+            std::uint64_t identity_;
+            ir::node_data<double>::dimensions_type dimensions_;
+            std::shared_ptr<lu_type const> lu_;
+            std::shared_ptr<cholesky_type const> cholesky_;
+            std::uint64_t last_used_;
+        };
+
+        // Only arrays which are referred to by someone else (usually the
+        // variable they are stored in) can be produced again. Arrays are
+        // modified in place only after being handed over by a variable for
+        // the last time, storing the new value invalidates the entry.
+        bool is_cacheable(primitive_argument_type const& operand,
+            ir::node_data<double> const& value)
+        {
+            return is_primitive_operand(operand) && value.is_shared() &&
+                !value.is_scalar() && !value.is_view() && !value.is_sparse() &&
+                value.is_contiguous();
+        }
+
+        class factorization_cache
+        {
+        private:
+            using mutex_type = hpx::lcos::local::spinlock;
+            using key_type = hpx::naming::gid_type;
+
+            template <typename Decomposition>
+            using member_type =
+                std::shared_ptr<Decomposition const> factorizations::*;
+
+        public:
+            factorization_cache()
+              : clock_(0)
+            {}
+
+            template <typename Decomposition, typename F>
+            std::shared_ptr<Decomposition const> get(
+                primitive_argument_type const& operand,
+                ir::node_data<double> const& value,
+                member_type<Decomposition> decomposition, F && factorize)
+            {
+                if (!is_cacheable(operand, value))
+                {
+                    return factorize(value);
+                }
+
+                key_type const key =
+                    primitive_operand(operand).get_id().get_gid();
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    auto it = entries_.find(key);
+                    if (it != entries_.end() &&
+                        it->second.is_same_array(value) &&
+                        it->second.*decomposition)
+                    {
+                        it->second.last_used_ = ++clock_;
+                        return it->second.*decomposition;
+                    }
+                }
+
+                // the matrix is factorized without holding the lock
+                std::shared_ptr<Decomposition const> result = factorize(value);
+
+                std::lock_guard<mutex_type> l(mtx_);
+                auto it = entries_.find(key);
+                if (it == entries_.end())
+                {
+                    if (entries_.size() >= PHYLANX_FACTORIZATION_CACHE_SIZE)
+                    {
+                        evict();
+                    }
+                    it = entries_.emplace(key, factorizations(value)).first;
+                }
+                else if (!it->second.is_same_array(value))
+                {
+                    it->second = factorizations(value);
+                }
+
+                it->second.*decomposition = result;
+                it->second.last_used_ = ++clock_;
+                return result;
+            }
+
+            void invalidate(primitive_argument_type const& operand)
+            {
+                if (!is_primitive_operand(operand))
+                {
+                    return;
+                }
+
+                key_type const key =
+                    primitive_operand(operand).get_id().get_gid();
+
+                std::lock_guard<mutex_type> l(mtx_);
+                entries_.erase(key);
+            }
+
+        private:
+            // drop the least recently used entry
+            void evict()
+            {
+                auto oldest = entries_.begin();
+                for (auto it = entries_.begin(); it != entries_.end(); ++it)
+                {
+                    if (it->second.last_used_ < oldest->second.last_used_)
+                    {
+                        oldest = it;
+                    }
+                }
+                if (oldest != entries_.end())
+                {
+                    entries_.erase(oldest);
+                }
+            }
+
+            mutex_type mtx_;
+            std::map<key_type, factorizations> entries_;
+            std::uint64_t clock_;
+        };
+
+        factorization_cache& get_factorization_cache()
+        {
+            static factorization_cache cache;
+            return cache;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<lu_type const> cached_lu(
+        primitive_argument_type const& operand,
+        ir::node_data<double> const& value)
+    {
+        return get_factorization_cache().get(operand, value,
+            &factorizations::lu_,
+            [](ir::node_data<double> const& value)
+            {
+                return std::make_shared<lu_type const>(value.matrix());
+            });
+    }
+
+    std::shared_ptr<cholesky_type const> cached_cholesky(
+        primitive_argument_type const& operand,
+        ir::node_data<double> const& value)
+    {
+        return get_factorization_cache().get(operand, value,
+            &factorizations::cholesky_,
+            [](ir::node_data<double> const& value)
+            {
+                auto result =
+                    std::make_shared<cholesky_type const>(value.matrix());
+                if (result->info() != Eigen::Success)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::primitives::detail::"
+                            "cached_cholesky",
+                        "the matrix is not positive definite (only its lower "
+                            "triangle is used)");
+                }
+                return result;
+            });
+    }
+
+    void invalidate_factorizations(primitive_argument_type const& operand)
+    {
+        get_factorization_cache().invalidate(operand);
+    }
+}}}}
@@ -0,0 +1,335 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/iterative_solvers.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    linear_operator::linear_operator(ir::node_data<double> const& matrix)
+      : is_sparse_(matrix.is_sparse())
+    {
+        if (is_sparse_)
+        {
+            sparse_ = matrix.sparse_matrix();
+        }
+        else
+        {
+            dense_ = matrix;
+        }
+    }
+
+    std::ptrdiff_t linear_operator::rows() const
+    {
+        return is_sparse_ ? sparse_.rows() : dense_.dimensions()[0];
+    }
+
+    std::ptrdiff_t linear_operator::cols() const
+    {
+        return is_sparse_ ? sparse_.cols() : dense_.dimensions()[1];
+    }
+
+    void linear_operator::apply(vector_type const& x, vector_type& y) const
+    {
+        std::ptrdiff_t const rows = this->rows();
+        double const work = is_sparse_ ?
+            double(sparse_.nonZeros()) : double(rows) * double(cols());
+
+        y.resize(rows);
+        if (work < double(parallel_elementwise_threshold))
+        {
+            if (is_sparse_)
+            {
+                y.noalias() = sparse_ * x;
+            }
+            else
+            {
+                y.noalias() = dense_.matrix() * x;
+            }
+            return;
+        }
+
+        // each task computes a block of rows holding roughly the same number
+        // of elements as the chunks of element-wise operations
+        std::ptrdiff_t const block = (std::max)(std::ptrdiff_t(1),
+            std::ptrdiff_t(double(rows) *
+                double(parallel_elementwise_chunk_size) / work));
+        std::ptrdiff_t const blocks = (rows + block - 1) / block;
+
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::ptrdiff_t(0), blocks,
+            [&](std::ptrdiff_t i)
+            {
+                std::ptrdiff_t const first = i * block;
+                std::ptrdiff_t const count = (std::min)(block, rows - first);
+                if (is_sparse_)
+                {
+                    y.segment(first, count).noalias() =
+                        sparse_.middleRows(first, count) * x;
+                }
+                else
+                {
+                    y.segment(first, count).noalias() =
+                        dense_.matrix().middleRows(first, count) * x;
+                }
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // The partial sums of the chunks are added in a fixed order, the
+        // result doesn't depend on the number of threads.
+        double dot(vector_type const& x, vector_type const& y)
+        {
+            std::ptrdiff_t const size = x.size();
+            std::vector<double> partial_sums(std::size_t(
+                (std::max)(std::ptrdiff_t(1),
+                    (size + parallel_elementwise_chunk_size - 1) /
+                        parallel_elementwise_chunk_size)), 0.0);
+
+            for_each_chunk(size,
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    partial_sums[first / parallel_elementwise_chunk_size] =
+                        x.segment(first, count).dot(y.segment(first, count));
+                });
+
+            return std::accumulate(
+                partial_sums.begin(), partial_sums.end(), 0.0);
+        }
+
+        // r = b - A * x
+        vector_type residual(linear_operator const& a, vector_type const& b,
+            vector_type const& x)
+        {
+            vector_type r;
+            a.apply(x, r);
+            for_each_chunk(r.size(),
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    r.segment(first, count) =
+                        b.segment(first, count) - r.segment(first, count);
+                });
+            return r;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    vector_type conjugate_gradient(linear_operator const& a,
+        vector_type const& b, vector_type x, iteration_control const& control)
+    {
+        double const b_norm2 = dot(b, b);
+        if (b_norm2 == 0.0)
+        {
+            return vector_type::Zero(b.size());
+        }
+        double const threshold =
+            control.tolerance * control.tolerance * b_norm2;
+
+        vector_type r = residual(a, b, x);
+        double r_norm2 = dot(r, r);
+
+        vector_type p = r;
+        vector_type ap(b.size());
+        for (std::ptrdiff_t i = 0;
+             i != control.max_iterations && r_norm2 > threshold; ++i)
+        {
+            a.apply(p, ap);
+            double const alpha = r_norm2 / dot(p, ap);
+
+            for_each_chunk(x.size(),
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    x.segment(first, count) += alpha * p.segment(first, count);
+                    r.segment(first, count) -=
+                        alpha * ap.segment(first, count);
+                });
+
+            double const r_norm2_new = dot(r, r);
+            double const beta = r_norm2_new / r_norm2;
+            r_norm2 = r_norm2_new;
+
+            for_each_chunk(p.size(),
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    p.segment(first, count) = r.segment(first, count) +
+                        beta * p.segment(first, count);
+                });
+        }
+        return x;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    vector_type bicgstab(linear_operator const& a, vector_type const& b,
+        vector_type x, iteration_control const& control)
+    {
+        double const b_norm2 = dot(b, b);
+        if (b_norm2 == 0.0)
+        {
+            return vector_type::Zero(b.size());
+        }
+        double const threshold =
+            control.tolerance * control.tolerance * b_norm2;
+
+        std::ptrdiff_t const size = b.size();
+
+        vector_type r = residual(a, b, x);
+        vector_type r0 = r;
+        double r_norm2 = dot(r, r);
+
+        double rho = 1.0;
+        double alpha = 1.0;
+        double omega = 1.0;
+        vector_type p = vector_type::Zero(size);
+        vector_type v = vector_type::Zero(size);
+        vector_type s(size);
+        vector_type t(size);
+
+        for (std::ptrdiff_t i = 0;
+             i != control.max_iterations && r_norm2 > threshold; ++i)
+        {
+            double rho_new = dot(r0, r);
+            if (rho_new == 0.0)
+            {
+                // the shadow residual became orthogonal, restart from the
+                // current residual
+                r0 = r;
+                rho_new = r_norm2;
+                rho = alpha = omega = 1.0;
+                p.setZero();
+                v.setZero();
+            }
+
+            double const beta = (rho_new / rho) * (alpha / omega);
+            rho = rho_new;
+
+            for_each_chunk(size,
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    p.segment(first, count) = r.segment(first, count) +
+                        beta * (p.segment(first, count) -
+                            omega * v.segment(first, count));
+                });
+
+            a.apply(p, v);
+            alpha = rho / dot(r0, v);
+
+            for_each_chunk(size,
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    s.segment(first, count) = r.segment(first, count) -
+                        alpha * v.segment(first, count);
+                });
+
+            a.apply(s, t);
+            double const t_norm2 = dot(t, t);
+            omega = t_norm2 > 0.0 ? dot(t, s) / t_norm2 : 0.0;
+
+            for_each_chunk(size,
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    x.segment(first, count) +=
+                        alpha * p.segment(first, count) +
+                        omega * s.segment(first, count);
+                    r.segment(first, count) = s.segment(first, count) -
+                        omega * t.segment(first, count);
+                });
+            r_norm2 = dot(r, r);
+
+            if (omega == 0.0)
+            {
+                break;      // the method stagnates
+            }
+        }
+        return x;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ir::node_data<double> iterative_solve(
+        iterative_method method, std::vector<ir::node_data<double>>&& ops)
+    {
+        std::string const name = method == iterative_method::cg ?
+            "phylanx::execution_tree::primitives::conjugate_gradient::eval" :
+            "phylanx::execution_tree::primitives::bicgstab::eval";
+
+        ir::node_data<double> const& matrix = ops[0];
+        ir::node_data<double> const& rhs = ops[1];
+
+        auto dims = matrix.dimensions();
+        if (matrix.num_dimensions() != 2 || dims[0] != dims[1])
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                "the matrix of the system has to be quadratic");
+        }
+        if (rhs.num_dimensions() != 1 ||
+            std::ptrdiff_t(rhs.size()) != dims[0])
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                "the right hand side has to be a vector matching the size "
+                    "of the matrix");
+        }
+
+        iteration_control control{1e-10, 2 * dims[0]};
+        if (ops.size() > 2)
+        {
+            if (ops[2].num_dimensions() != 0 || !(ops[2][0] >= 0.0))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                    "the tolerance has to be a non-negative number");
+            }
+            control.tolerance = ops[2][0];
+        }
+        if (ops.size() > 3)
+        {
+            if (ops[3].num_dimensions() != 0 || !(ops[3][0] >= 0.0))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                    "the maximal number of iterations has to be a "
+                        "non-negative number");
+            }
+            control.max_iterations = std::ptrdiff_t(ops[3][0]);
+        }
+
+        vector_type x = vector_type::Zero(dims[0]);
+        if (ops.size() > 4)
+        {
+            if (ops[4].num_dimensions() != 1 ||
+                std::ptrdiff_t(ops[4].size()) != dims[0])
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                    "the initial approximation has to be a vector matching "
+                        "the size of the matrix");
+            }
+            x = ops[4].matrix();
+        }
+
+        linear_operator const a(matrix);
+        vector_type const b = rhs.matrix();
+        if (method == iterative_method::cg)
+        {
+            return ir::node_data<double>(
+                conjugate_gradient(a, b, std::move(x), control));
+        }
+        return ir::node_data<double>(bicgstab(a, b, std::move(x), control));
+    }
+}}}}
@@ -0,0 +1,108 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/blas_backend.hpp>
+#include <phylanx/execution_tree/primitives/detail/matrix_product.hpp>
+
+#include <hpx/exception.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        std::size_t config_value(char const* key, std::size_t dflt)
+        {
+            return hpx::util::safe_lexical_cast<std::size_t>(
+                hpx::get_config_entry(key, dflt), dflt);
+        }
+
+        // the settings are read once, on first use
+        std::ptrdiff_t dot_tile_size()
+        {
+            static std::ptrdiff_t const tile_size = (std::max)(
+                std::ptrdiff_t(config_value(
+                    "phylanx.dot.tile_size", PHYLANX_DOT_TILE_SIZE)),
+                std::ptrdiff_t(1));
+            return tile_size;
+        }
+
+        double dot_parallel_threshold()
+        {
+            static double const threshold = double(config_value(
+                "phylanx.dot.parallel_threshold",
+                PHYLANX_DOT_PARALLEL_THRESHOLD));
+            return threshold;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        void multiply(const_matrix_ref const& lhs, const_matrix_ref const& rhs,
+            matrix_ref result)
+        {
+            if (!blas_matrix_product(lhs, rhs, result))
+            {
+                result.noalias() = lhs * rhs;
+            }
+        }
+    }
+
+    matrix_type matrix_product(
+        const_matrix_ref const& lhs, const_matrix_ref const& rhs)
+    {
+        if (lhs.cols() != rhs.rows())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "matrix_product",
+                "the operands have incompatible number of dimensions");
+        }
+
+        std::ptrdiff_t const rows = lhs.rows();
+        std::ptrdiff_t const cols = rhs.cols();
+        std::ptrdiff_t const tile = dot_tile_size();
+
+        matrix_type result(rows, cols);
+        if (double(rows) * double(cols) * double(lhs.cols()) <
+                dot_parallel_threshold() ||
+            (rows <= tile && cols <= tile))
+        {
+            multiply(lhs, rhs, result);
+            return result;
+        }
+
+        // each tile of the result is the product of a block of rows of lhs
+        // and a block of columns of rhs, BLAS or Eigen block the tile
+        // products for the caches
+        std::ptrdiff_t const row_tiles = (rows + tile - 1) / tile;
+        std::ptrdiff_t const col_tiles = (cols + tile - 1) / tile;
+
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::ptrdiff_t(0), row_tiles * col_tiles,
+            [&](std::ptrdiff_t t)
+            {
+                std::ptrdiff_t const row = (t / col_tiles) * tile;
+                std::ptrdiff_t const col = (t % col_tiles) * tile;
+                std::ptrdiff_t const tile_rows = (std::min)(tile, rows - row);
+                std::ptrdiff_t const tile_cols = (std::min)(tile, cols - col);
+
+                auto block = result.block(row, col, tile_rows, tile_cols);
+                multiply(lhs.middleRows(row, tile_rows),
+                    rhs.middleCols(col, tile_cols), block);
+            });
+        return result;
+    }
+}}}}
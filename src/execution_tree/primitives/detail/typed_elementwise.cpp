@@ -0,0 +1,549 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
+#include <phylanx/execution_tree/primitives/detail/typed_elementwise.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/throw_exception.hpp>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives {
+    namespace detail
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The element types ordered by their rank (see ir::promoted_type)
+        enum element_kind
+        {
+            no_kind = -1,
+            uint8_kind = 0,
+            int64_kind = 1,
+            float_kind = 2,
+            double_kind = 3
+        };
+
+        int element_kind_of(primitive_result_type const& val)
+        {
+            switch (val.index())
+            {
+            case 4:     // phylanx::ir::node_data<double>
+                return double_kind;
+
+            case 5:     // phylanx::ir::node_data<float>
+                return float_kind;
+
+            case 6:     // phylanx::ir::node_data<std::int64_t>
+                return int64_kind;
+
+            case 7:     // phylanx::ir::node_data<std::uint8_t>
+                return uint8_kind;
+
+            default:
+                break;
+            }
+            return no_kind;
+        }
+
+        bool is_scalar_value(primitive_result_type const& val)
+        {
+            switch (val.index())
+            {
+            case 4:
+                return util::get<4>(val).num_dimensions() == 0;
+
+            case 5:
+                return util::get<5>(val).num_dimensions() == 0;
+
+            case 6:
+                return util::get<6>(val).num_dimensions() == 0;
+
+            case 7:
+                return util::get<7>(val).num_dimensions() == 0;
+
+            default:
+                break;
+            }
+            return false;
+        }
+
+        // Element type used to combine two operands, a 0-dimensional double
+        // (e.g. a literal) does not turn a float array into a double array.
+        int promoted_kind(int lhs, bool lhs_scalar, int rhs, bool rhs_scalar)
+        {
+            if ((lhs == double_kind && lhs_scalar && rhs == float_kind) ||
+                (rhs == double_kind && rhs_scalar && lhs == float_kind))
+            {
+                return float_kind;
+            }
+            if ((lhs == int64_kind && rhs == float_kind) ||
+                (lhs == float_kind && rhs == int64_kind))
+            {
+                return double_kind;
+            }
+            return (std::max)(lhs, rhs);
+        }
+
+        // Element type used for arithmetic, boolean masks are added,
+        // subtracted, and multiplied as int64 (as NumPy does for bool) to
+        // avoid wrapping around.
+        int arithmetic_kind(int kind)
+        {
+            return (std::max)(kind, int(int64_kind));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename R>
+        ir::node_data<R> convert(ir::node_data<R>&& val)
+        {
+            return std::move(val);
+        }
+
+        template <typename R, typename U, typename Enable =
+            typename std::enable_if<!std::is_same<R, U>::value>::type>
+        ir::node_data<R> convert(ir::node_data<U>&& val)
+        {
+            return ir::node_data<R>(val);
+        }
+
+        // the kernels below access the (dense and contiguous) data directly
+        template <typename R>
+        ir::node_data<R> value_as(primitive_result_type&& val)
+        {
+            ir::node_data<R> result;
+            switch (val.index())
+            {
+            case 4:
+                result = convert<R>(util::get<4>(std::move(val)));
+                break;
+
+            case 5:
+                result = convert<R>(util::get<5>(std::move(val)));
+                break;
+
+            case 6:
+                result = convert<R>(util::get<6>(std::move(val)));
+                break;
+
+            case 7:
+                result = convert<R>(util::get<7>(std::move(val)));
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::detail::value_as",
+                    "primitive_result_type does not hold a numeric value "
+                        "type");
+            }
+
+            if (result.is_sparse())
+            {
+                result.matrix();        // mutable access makes it dense
+            }
+            return result.contiguous();
+        }
+
+        template <typename R>
+        using array_map = Eigen::Map<Eigen::Array<R, Eigen::Dynamic, 1>>;
+
+        template <typename R>
+        using const_array_map =
+            Eigen::Map<Eigen::Array<R, Eigen::Dynamic, 1> const>;
+
+        ///////////////////////////////////////////////////////////////////////
+        struct add_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x + y)
+            {
+                return x + y;
+            }
+        };
+
+        struct sub_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x - y)
+            {
+                return x - y;
+            }
+        };
+
+        struct mul_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x * y)
+            {
+                return x * y;
+            }
+        };
+
+        struct div_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x / y)
+            {
+                return x / y;
+            }
+        };
+
+        struct less_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x < y)
+            {
+                return x < y;
+            }
+        };
+
+        struct less_equal_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x <= y)
+            {
+                return x <= y;
+            }
+        };
+
+        struct greater_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x > y)
+            {
+                return x > y;
+            }
+        };
+
+        struct greater_equal_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x >= y)
+            {
+                return x >= y;
+            }
+        };
+
+        struct equal_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x == y)
+            {
+                return x == y;
+            }
+        };
+
+        struct not_equal_elements
+        {
+            template <typename X, typename Y>
+            auto operator()(X const& x, Y const& y) const -> decltype(x != y)
+            {
+                return x != y;
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // the result is computed in place of the array operand
+        template <typename R, typename F>
+        ir::node_data<R> combine_pair(ir::node_data<R>&& lhs,
+            ir::node_data<R>&& rhs, F const& f, char const* name)
+        {
+            bool const lhs_scalar = lhs.num_dimensions() == 0;
+            bool const rhs_scalar = rhs.num_dimensions() == 0;
+
+            if (lhs_scalar && rhs_scalar)
+            {
+                return ir::node_data<R>(R(f(lhs[0], rhs[0])));
+            }
+
+            if (lhs_scalar)
+            {
+                R const value = lhs[0];
+                R* data = rhs.data();
+                for_each_chunk(std::ptrdiff_t(rhs.size()),
+                    [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                    {
+                        array_map<R> y(data + first, count);
+                        y = f(value, y);
+                    });
+                return std::move(rhs);
+            }
+
+            if (rhs_scalar)
+            {
+                R const value = rhs[0];
+                R* data = lhs.data();
+                for_each_chunk(std::ptrdiff_t(lhs.size()),
+                    [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                    {
+                        array_map<R> x(data + first, count);
+                        x = f(x, value);
+                    });
+                return std::move(lhs);
+            }
+
+            if (lhs.shape() != rhs.shape())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                    "the dimensions of the operands do not match");
+            }
+
+            // the data of rhs is acquired before lhs makes its data unique
+            ir::node_data<R> const& crhs = rhs;
+            R const* rhs_data = crhs.data();
+            R* lhs_data = lhs.data();
+            for_each_chunk(std::ptrdiff_t(lhs.size()),
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    array_map<R> x(lhs_data + first, count);
+                    const_array_map<R> y(rhs_data + first, count);
+                    x = f(x, y);
+                });
+            return std::move(lhs);
+        }
+
+        template <typename R, typename F>
+        primitive_result_type compare_pair(ir::node_data<R>&& lhs,
+            ir::node_data<R>&& rhs, F const& f, char const* name)
+        {
+            if (lhs.num_dimensions() != rhs.num_dimensions())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                    "the operands have incompatible number of dimensions");
+            }
+
+            if (lhs.num_dimensions() == 0)
+            {
+                return primitive_result_type(bool(f(lhs[0], rhs[0])));
+            }
+
+            if (lhs.shape() != rhs.shape())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                    "the dimensions of the operands do not match");
+            }
+
+            auto dims = lhs.dimensions();
+            ir::node_data<std::uint8_t>::storage_type mask(dims[0], dims[1]);
+
+            ir::node_data<R> const& clhs = lhs;
+            ir::node_data<R> const& crhs = rhs;
+            R const* lhs_data = clhs.data();
+            R const* rhs_data = crhs.data();
+            std::uint8_t* mask_data = mask.data();
+            for_each_chunk(std::ptrdiff_t(lhs.size()),
+                [&](std::ptrdiff_t first, std::ptrdiff_t count)
+                {
+                    array_map<std::uint8_t> m(mask_data + first, count);
+                    const_array_map<R> x(lhs_data + first, count);
+                    const_array_map<R> y(rhs_data + first, count);
+                    m = f(x, y).template cast<std::uint8_t>();
+                });
+
+            ir::node_data<std::uint8_t> result(std::move(mask));
+            if (lhs.num_dimensions() > 2)
+            {
+                result = result.reshape(lhs.shape());
+            }
+            return primitive_result_type(std::move(result));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename F>
+        primitive_result_type combine_values(int kind,
+            primitive_result_type&& lhs, primitive_result_type&& rhs,
+            F const& f, char const* name)
+        {
+            switch (kind)
+            {
+            case uint8_kind:
+                return primitive_result_type(combine_pair(
+                    value_as<std::uint8_t>(std::move(lhs)),
+                    value_as<std::uint8_t>(std::move(rhs)), f, name));
+
+            case int64_kind:
+                return primitive_result_type(combine_pair(
+                    value_as<std::int64_t>(std::move(lhs)),
+                    value_as<std::int64_t>(std::move(rhs)), f, name));
+
+            case float_kind:
+                return primitive_result_type(combine_pair(
+                    value_as<float>(std::move(lhs)),
+                    value_as<float>(std::move(rhs)), f, name));
+
+            default:
+                return primitive_result_type(combine_pair(
+                    value_as<double>(std::move(lhs)),
+                    value_as<double>(std::move(rhs)), f, name));
+            }
+        }
+
+        template <typename F>
+        primitive_result_type compare_values(int kind,
+            primitive_result_type&& lhs, primitive_result_type&& rhs,
+            F const& f, char const* name)
+        {
+            switch (kind)
+            {
+            case uint8_kind:
+                return compare_pair(value_as<std::uint8_t>(std::move(lhs)),
+                    value_as<std::uint8_t>(std::move(rhs)), f, name);
+
+            case int64_kind:
+                return compare_pair(value_as<std::int64_t>(std::move(lhs)),
+                    value_as<std::int64_t>(std::move(rhs)), f, name);
+
+            case float_kind:
+                return compare_pair(value_as<float>(std::move(lhs)),
+                    value_as<float>(std::move(rhs)), f, name);
+
+            default:
+                return compare_pair(value_as<double>(std::move(lhs)),
+                    value_as<double>(std::move(rhs)), f, name);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool is_typed_operation(
+        typed_operation op, std::vector<primitive_result_type> const& ops)
+    {
+        if (ops.size() < 2)
+        {
+            return false;
+        }
+
+        if (op == typed_operation::mul &&
+            (ops.size() != 2 ||
+                (!is_scalar_value(ops[0]) && !is_scalar_value(ops[1]))))
+        {
+            return false;
+        }
+
+        int kind = element_kind_of(ops[0]);
+        bool scalar = is_scalar_value(ops[0]);
+        for (auto it = ops.begin() + 1; it != ops.end(); ++it)
+        {
+            int const curr = element_kind_of(*it);
+            if (kind == no_kind || curr == no_kind)
+            {
+                return false;
+            }
+
+            bool const curr_scalar = is_scalar_value(*it);
+            kind = promoted_kind(kind, scalar, curr, curr_scalar);
+            scalar = scalar && curr_scalar;
+        }
+
+        if (op == typed_operation::div && kind < float_kind)
+        {
+            return false;
+        }
+        return arithmetic_kind(kind) != double_kind;
+    }
+
+    primitive_result_type typed_elementwise(typed_operation op,
+        std::vector<primitive_result_type>&& ops, char const* name)
+    {
+        primitive_result_type result = std::move(ops[0]);
+        for (auto it = ops.begin() + 1; it != ops.end(); ++it)
+        {
+            int const kind = arithmetic_kind(promoted_kind(
+                element_kind_of(result), is_scalar_value(result),
+                element_kind_of(*it), is_scalar_value(*it)));
+
+            switch (op)
+            {
+            case typed_operation::add:
+                result = combine_values(kind, std::move(result),
+                    std::move(*it), add_elements{}, name);
+                break;
+
+            case typed_operation::sub:
+                result = combine_values(kind, std::move(result),
+                    std::move(*it), sub_elements{}, name);
+                break;
+
+            case typed_operation::mul:
+                result = combine_values(kind, std::move(result),
+                    std::move(*it), mul_elements{}, name);
+                break;
+
+            case typed_operation::div:
+                result = combine_values((std::max)(kind, int(float_kind)),
+                    std::move(result), std::move(*it), div_elements{}, name);
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                    "unexpected element-wise operation");
+            }
+        }
+        return result;
+    }
+
+    primitive_result_type compare_elements(typed_operation op,
+        primitive_result_type&& lhs, primitive_result_type&& rhs,
+        char const* name)
+    {
+        int const kind = promoted_kind(element_kind_of(lhs),
+            is_scalar_value(lhs), element_kind_of(rhs), is_scalar_value(rhs));
+
+        switch (op)
+        {
+        case typed_operation::less:
+            return compare_values(kind, std::move(lhs), std::move(rhs),
+                less_elements{}, name);
+
+        case typed_operation::less_equal:
+            return compare_values(kind, std::move(lhs), std::move(rhs),
+                less_equal_elements{}, name);
+
+        case typed_operation::greater:
+            return compare_values(kind, std::move(lhs), std::move(rhs),
+                greater_elements{}, name);
+
+        case typed_operation::greater_equal:
+            return compare_values(kind, std::move(lhs), std::move(rhs),
+                greater_equal_elements{}, name);
+
+        case typed_operation::equal:
+            return compare_values(kind, std::move(lhs), std::move(rhs),
+                equal_elements{}, name);
+
+        case typed_operation::not_equal:
+            return compare_values(kind, std::move(lhs), std::move(rhs),
+                not_equal_elements{}, name);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+            "unexpected comparison operation");
+    }
+
+    std::vector<ir::node_data<double>> numeric_values(
+        std::vector<primitive_result_type>&& ops)
+    {
+        std::vector<ir::node_data<double>> result;
+        result.reserve(ops.size());
+        for (auto& op : ops)
+        {
+            result.push_back(extract_numeric_value(std::move(op)));
+        }
+        return result;
+    }
+}}}}
@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/execution_tree/primitives/detail/factorization_cache.hpp>
 #include <phylanx/execution_tree/primitives/determinant.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/serialization/eigen.hpp>
@@ -108,7 +109,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             primitive_result_type determinantxd(operands_type && ops) const
             {
-                return operand_type(ops[0].matrix().determinant());
+                operand_type const& op = ops[0];
+                auto dims = op.dimensions();
+                if (dims[0] != dims[1])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "determinant::determinantxd",
+                        "the determinant primitive requires a quadratic "
+                            "matrix");
+                }
+
+                // the LU decomposition is shared with solve and lu
+                return operand_type(
+                    cached_lu(operands_[0], op)->determinant());
             }
 
         private:
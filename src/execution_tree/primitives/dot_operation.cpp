@@ -4,6 +4,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/matrix_product.hpp>
 #include <phylanx/execution_tree/primitives/dot_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/optional.hpp>
@@ -99,6 +100,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
         protected:
             using operand_type = ir::node_data<double>;
             using operands_type = std::vector<operand_type>;
+            using vector_map_type = Eigen::Map<Eigen::VectorXd const>;
+            using matrix_type = operand_type::storage_type;
+            using sparse_matrix_type = operand_type::sparse_storage_type;
 
             primitive_result_type dot0d(operands_type && ops) const
             {
@@ -116,8 +120,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             // lhs_num_dims == 1
             primitive_result_type dot1d(operands_type && ops) const
             {
-                operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
+                operand_type const& lhs = ops[0];
+                operand_type const& rhs = ops[1];
 
                 std::size_t rhs_num_dims = rhs.num_dimensions();
                 if (rhs_num_dims == 0)
@@ -137,9 +141,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                 "dimensions");
                     }
 
-                    double result =
-                        Eigen::Map<Eigen::VectorXd>(lhs.data(), lhs.size()).dot(
-                            Eigen::Map<Eigen::VectorXd>(rhs.data(), rhs.size()));
+                    double result = vector_map_type(lhs.data(), lhs.size())
+                        .dot(vector_map_type(rhs.data(), rhs.size()));
 
                     return ir::node_data<double>(result);
                 }
@@ -162,9 +165,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "dimensions");
                 }
 
-                double result =
-                    Eigen::Map<Eigen::VectorXd>(lhs.data(), lhs.size()).dot(
-                        Eigen::Map<Eigen::VectorXd>(rhs.data(), rhs.size()));
+                double result = vector_map_type(lhs.data(), lhs.size())
+                    .dot(vector_map_type(rhs.data(), rhs.size()));
 
                 return ir::node_data<double>(result);
             }
@@ -172,33 +174,39 @@ namespace phylanx { namespace execution_tree { namespace primitives
             // lhs_num_dims == 2
             primitive_result_type dot2d(operands_type && ops) const
             {
-                operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
+                operand_type const& lhs = ops[0];
+                operand_type const& rhs = ops[1];
 
                 std::size_t rhs_num_dims = rhs.num_dimensions();
-                if (rhs_num_dims == 0 || rhs_num_dims == 2)
+                if (rhs_num_dims == 0 || lhs.dimension(1) != rhs.dimension(0))
                 {
                     HPX_THROW_EXCEPTION(hpx::bad_parameter,
                         "dot_operation::dot2d",
                         "the operands have incompatible number of "
                             "dimensions");
                 }
-                else
+
+                // matrix-vector or matrix-matrix product, sparse operands
+                // are multiplied without converting them to dense arrays
+                if (lhs.is_sparse())
                 {
-                    if (lhs.dimension(1) != rhs.dimension(0))
+                    if (rhs.is_sparse())
                     {
-                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                            "dot_operation::dot2d",
-                            "the operands have incompatible number of "
-                                "dimensions");
+                        return operand_type(sparse_matrix_type(
+                            lhs.sparse_matrix() * rhs.sparse_matrix()));
                     }
+                    return operand_type(
+                        matrix_type(lhs.sparse_matrix() * rhs.matrix()));
+                }
 
-                    double result =
-                        Eigen::Map<Eigen::VectorXd>(lhs.data(), lhs.size()).dot(
-                            Eigen::Map<Eigen::VectorXd>(rhs.data(), rhs.size()));
-
-                    return ir::node_data<double>(result);
+                if (rhs.is_sparse())
+                {
+                    return operand_type(
+                        matrix_type(lhs.matrix() * rhs.sparse_matrix()));
                 }
+
+                return operand_type(
+                    detail::matrix_product(lhs.matrix(), rhs.matrix()));
             }
 
         private:
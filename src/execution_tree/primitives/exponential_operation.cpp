@@ -4,6 +4,7 @@
 //   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
 #include <phylanx/execution_tree/primitives/exponential_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/serialization/eigen.hpp>
@@ -62,16 +63,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     ///////////////////////////////////////////////////////////////////////////
     ir::node_data<double> exponential_operation::exponential0d(
-        operands_type && ops) const
+        operands_type && ops)
     {
         ops[0][0] = std::exp(ops[0][0]);
         return std::move(ops[0]);
     }
 
     ir::node_data<double> exponential_operation::exponential1d(
-        operands_type && ops) const
+        operands_type && ops)
     {
-        auto const& val = ops[0].matrix();
+        operand_type const& op = ops[0];
+        auto const& val = op.matrix();
         if (val.rows() != val.cols())
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
@@ -81,14 +83,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         using matrix_type = Eigen::Matrix<double, Eigen::Dynamic, 1>;
 
-        matrix_type result = ops[0].matrix().exp();
+        matrix_type result = val.exp();
         return ir::node_data<double>(std::move(result));
     }
 
     ir::node_data<double> exponential_operation::exponentialxd(
-        operands_type && ops) const
+        operands_type && ops)
     {
-        auto const& val = ops[0].matrix();
+        operand_type const& op = ops[0];
+        auto const& val = op.matrix();
         if (val.rows() != val.cols())
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
@@ -99,33 +102,47 @@ namespace phylanx { namespace execution_tree { namespace primitives
         using matrix_type =
             Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>;
 
-        matrix_type result = ops[0].matrix().exp();
+        matrix_type result = val.exp();
         return ir::node_data<double>(std::move(result));
     }
 
+    // arrays with more than two dimensions are exponentiated element-wise
+    ir::node_data<double> exponential_operation::exponentialnd(
+        operands_type && ops)
+    {
+        transform(ops[0],
+            [](array_segment const& x)
+            {
+                return x.exp();
+            });
+        return std::move(ops[0]);
+    }
+
+    primitive_result_type exponential_operation::apply(operands_type && ops)
+    {
+        std::size_t dims = ops[0].num_dimensions();
+        switch (dims)
+        {
+        case 0:
+            return primitive_result_type(exponential0d(std::move(ops)));
+
+        case 1:
+            return primitive_result_type(exponential1d(std::move(ops)));
+
+        case 2:
+            return primitive_result_type(exponentialxd(std::move(ops)));
+
+        default:
+            return primitive_result_type(exponentialnd(std::move(ops)));
+        }
+    }
+
     hpx::future<primitive_result_type> exponential_operation::eval() const
     {
         return hpx::dataflow(hpx::util::unwrapping(
-            [this](operands_type&& ops) -> primitive_result_type
+            [](operands_type&& ops) -> primitive_result_type
             {
-                std::size_t dims = ops[0].num_dimensions();
-                switch (dims)
-                {
-                case 0:
-                    return primitive_result_type(exponential0d(std::move(ops)));
-
-                case 1:
-                    return primitive_result_type(exponential1d(std::move(ops)));
-
-                case 2:
-                    return primitive_result_type(exponentialxd(std::move(ops)));
-
-                default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "exponential_operation::eval",
-                        "left hand side operand has unsupported number of "
-                            "dimensions");
-                }
+                return apply(std::move(ops));
             }),
             detail::map_operands(operands_, numeric_operand)
         );
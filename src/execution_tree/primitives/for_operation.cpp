@@ -61,6 +61,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
     }
 
+    for_operation::for_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::vector<primitive_argument_type>&& invariants)
+      : for_operation(std::move(operands))
+    {
+        for (auto const& invariant : invariants)
+        {
+            if (!is_primitive_operand(invariant))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::for_operation::"
+                        "for_operation",
+                    "the loop invariants of the for_operation primitive "
+                        "must be primitives");
+            }
+        }
+        invariants_ = std::move(invariants);
+    }
+
     namespace detail
     {
         struct iteration_for : std::enable_shared_from_this<iteration_for>
@@ -138,6 +157,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
     // start iteration over given for statement
     hpx::future<primitive_result_type> for_operation::eval() const
     {
-      return std::make_shared<detail::iteration_for>(operands_)->init();
+        // the loop invariants are evaluated at most once per execution of
+        // the loop
+        for (auto const& invariant : invariants_)
+        {
+            primitive_operand(invariant).store(
+                hpx::launch::sync, primitive_result_type{});
+        }
+
+        return std::make_shared<detail::iteration_for>(operands_)->init();
     }
 }}}
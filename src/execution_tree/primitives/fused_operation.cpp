@@ -0,0 +1,659 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/add_operation.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
+#include <phylanx/execution_tree/primitives/div_operation.hpp>
+#include <phylanx/execution_tree/primitives/exponential_operation.hpp>
+#include <phylanx/execution_tree/primitives/fused_operation.hpp>
+#include <phylanx/execution_tree/primitives/mul_operation.hpp>
+#include <phylanx/execution_tree/primitives/sub_operation.hpp>
+#include <phylanx/execution_tree/primitives/unary_minus_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/eigen.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::fused_operation>
+    fused_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(fused_operation_type,
+    phylanx_fused_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(fused_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    void fused_instruction::serialize(
+        hpx::serialization::output_archive& ar, unsigned)
+    {
+        std::int8_t val = static_cast<std::int8_t>(op);
+        ar << val << args;
+    }
+
+    void fused_instruction::serialize(
+        hpx::serialization::input_archive& ar, unsigned)
+    {
+        std::int8_t val;
+        ar >> val >> args;
+        op = static_cast<opcode>(val);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    fused_operation::fused_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::vector<fused_instruction>&& program)
+      : operands_(std::move(operands))
+      , program_(std::move(program))
+    {
+        if (program_.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_operation::fused_operation",
+                "the fused_operation primitive requires a non-empty program");
+        }
+
+        for (std::size_t i = 0; i != operands_.size(); ++i)
+        {
+            if (!valid(operands_[i]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "fused_operation::fused_operation",
+                    "the fused_operation primitive requires that the "
+                        "arguments given by the operands array are valid");
+            }
+        }
+
+        // The program has to describe a tree: every operand is loaded exactly
+        // once and every computed value is used exactly once (except for the
+        // last one, which is the result). This allows to move the values
+        // while executing the program.
+        std::vector<std::size_t> loads(operands_.size(), 0);
+        std::vector<std::size_t> uses(program_.size(), 0);
+
+        for (std::size_t i = 0; i != program_.size(); ++i)
+        {
+            fused_instruction const& inst = program_[i];
+
+            std::size_t min_args = 2;
+            std::size_t max_args = std::size_t(-1);
+            switch (inst.op)
+            {
+            case fused_instruction::opcode::load: HPX_FALLTHROUGH;
+            case fused_instruction::opcode::negate: HPX_FALLTHROUGH;
+            case fused_instruction::opcode::exp:
+                min_args = max_args = 1;
+                break;
+
+            default:
+                break;
+            }
+
+            if (inst.args.size() < min_args || inst.args.size() > max_args)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "fused_operation::fused_operation",
+                    "invalid number of arguments for instruction " +
+                        std::to_string(i));
+            }
+
+            for (std::size_t arg : inst.args)
+            {
+                bool valid_arg = (inst.op == fused_instruction::opcode::load) ?
+                    (arg < operands_.size() && loads[arg]++ == 0) :
+                    (arg < i && uses[arg]++ == 0);
+
+                if (!valid_arg)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "fused_operation::fused_operation",
+                        "instruction " + std::to_string(i) +
+                            " refers to an invalid or already used value");
+                }
+            }
+        }
+
+        if (std::count(loads.begin(), loads.end(), 0) != 0 ||
+            std::count(uses.begin(), uses.end() - 1, 0) != 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_operation::fused_operation",
+                "the program of the fused_operation primitive must use all "
+                    "operands and intermediate values");
+        }
+    }
+
+    fused_operation::fused_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::vector<fused_instruction>&& program,
+            std::vector<shape_type>&& shapes)
+      : fused_operation(std::move(operands), std::move(program))
+    {
+        shapes_ = std::move(shapes);
+        if (shapes_.size() != program_.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_operation::fused_operation",
+                "the fused_operation primitive requires one shape for each "
+                    "instruction of its program");
+        }
+
+        // the program has to be element-wise for the given shapes
+        for (std::size_t i = 0; i != program_.size(); ++i)
+        {
+            shape_type shape;
+            if (program_[i].op != fused_instruction::opcode::load &&
+                (!elementwise_shape(program_[i], shapes_, shape) ||
+                    shape != shapes_[i]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "fused_operation::fused_operation",
+                    "the given shapes don't describe an element-wise "
+                        "execution of instruction " + std::to_string(i));
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using operand_type = fused_operation::operand_type;
+        using operands_type = fused_operation::operands_type;
+        using shape_type = operand_type::shape_type;
+        using opcode = fused_instruction::opcode;
+
+        // number of elements processed at once, the intermediate blocks of
+        // all instructions should comfortably fit into the L1 cache
+        constexpr std::ptrdiff_t fused_block_size = 256;
+
+        ///////////////////////////////////////////////////////////////////////
+        // 0-dimensional values have an empty shape
+        bool elementwise_shape(fused_instruction const& inst,
+            std::vector<shape_type> const& shapes, shape_type& result)
+        {
+            switch (inst.op)
+            {
+            case opcode::negate:
+                result = shapes[inst.args[0]];
+                return true;
+
+            case opcode::exp:
+                // vectors and matrices are exponentiated as a whole
+                result = shapes[inst.args[0]];
+                return result.empty() || result.size() > 2;
+
+            default:
+                break;
+            }
+
+            std::size_t num_arrays = 0;
+            result.clear();
+            for (std::size_t arg : inst.args)
+            {
+                shape_type const& shape = shapes[arg];
+                if (shape.empty())
+                {
+                    continue;
+                }
+                if (num_arrays++ == 0)
+                {
+                    result = shape;
+                }
+                else if (shape != result)
+                {
+                    return false;
+                }
+            }
+
+            if (num_arrays == 0)
+            {
+                return true;
+            }
+
+            bool const first_is_array = !shapes[inst.args[0]].empty();
+            if (inst.op == opcode::mul)
+            {
+                // products of arrays are matrix products, multiplying an
+                // array by more than one scalar requires the array to come
+                // first
+                return num_arrays == 1 && result.size() <= 2 &&
+                    (inst.args.size() == 2 || first_is_array);
+            }
+
+            // arrays can be combined with a single scalar only
+            return num_arrays == inst.args.size() || inst.args.size() == 2;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // A (block of a) value while executing a program: either a scalar or
+        // a pointer to the current block of elements.
+        struct fused_value
+        {
+            double const* data;
+            double scalar;
+        };
+
+        using array_type = Eigen::Array<double, Eigen::Dynamic, 1>;
+        using array_map = Eigen::Map<array_type>;
+        using const_array_map = Eigen::Map<array_type const>;
+
+        double apply_scalar(opcode op, fused_value const* args, std::size_t n)
+        {
+            double result = args[0].scalar;
+            switch (op)
+            {
+            case opcode::negate:
+                return -result;
+
+            case opcode::exp:
+                return std::exp(result);
+
+            case opcode::add:
+                for (std::size_t i = 1; i != n; ++i) result += args[i].scalar;
+                break;
+
+            case opcode::sub:
+                for (std::size_t i = 1; i != n; ++i) result -= args[i].scalar;
+                break;
+
+            case opcode::mul:
+                for (std::size_t i = 1; i != n; ++i) result *= args[i].scalar;
+                break;
+
+            case opcode::div:
+                for (std::size_t i = 1; i != n; ++i) result /= args[i].scalar;
+                break;
+
+            default:
+                break;
+            }
+            return result;
+        }
+
+        void apply_block(opcode op, fused_value const* args, std::size_t n,
+            double* out, std::ptrdiff_t size)
+        {
+            array_map result(out, size);
+
+            if (op == opcode::negate)
+            {
+                result = -const_array_map(args[0].data, size);
+                return;
+            }
+            if (op == opcode::exp)
+            {
+                result = const_array_map(args[0].data, size).exp();
+                return;
+            }
+
+            if (args[0].data == nullptr)
+            {
+                result.setConstant(args[0].scalar);
+            }
+            else
+            {
+                result = const_array_map(args[0].data, size);
+            }
+
+            for (std::size_t i = 1; i != n; ++i)
+            {
+                if (args[i].data == nullptr)
+                {
+                    double const rhs = args[i].scalar;
+                    switch (op)
+                    {
+                    case opcode::add: result += rhs; break;
+                    case opcode::sub: result -= rhs; break;
+                    case opcode::mul: result *= rhs; break;
+                    case opcode::div: result /= rhs; break;
+                    default: break;
+                    }
+                }
+                else
+                {
+                    const_array_map rhs(args[i].data, size);
+                    switch (op)
+                    {
+                    case opcode::add: result += rhs; break;
+                    case opcode::sub: result -= rhs; break;
+                    case opcode::mul: result *= rhs; break;
+                    case opcode::div: result /= rhs; break;
+                    default: break;
+                    }
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Execute the program for the elements [first, last) block by block,
+        // all 0-dimensional values have been computed already.
+        void execute_blocks(operands_type const& ops,
+            std::vector<fused_instruction> const& program,
+            std::vector<shape_type> const& shapes,
+            std::vector<fused_value> values, double* out,
+            std::ptrdiff_t first, std::ptrdiff_t last)
+        {
+            std::size_t const num_instructions = program.size();
+
+            std::vector<fused_value> args;
+            std::vector<array_type> blocks(num_instructions);
+
+            for (/**/; first < last; first += fused_block_size)
+            {
+                std::ptrdiff_t const count =
+                    (std::min)(fused_block_size, last - first);
+
+                for (std::size_t i = 0; i != num_instructions; ++i)
+                {
+                    if (shapes[i].empty())
+                    {
+                        continue;
+                    }
+
+                    fused_instruction const& inst = program[i];
+                    if (inst.op == opcode::load)
+                    {
+                        operand_type const& op = ops[inst.args[0]];
+                        values[i].data = op.data() + first;
+                        continue;
+                    }
+
+                    args.clear();
+                    for (std::size_t arg : inst.args)
+                    {
+                        args.push_back(values[arg]);
+                    }
+
+                    // the first argument is combined with the others in
+                    // place, the output may alias the first argument only
+                    double* block = out + first;
+                    if (i + 1 != num_instructions ||
+                        std::any_of(args.begin() + 1, args.end(),
+                            [&](fused_value const& arg)
+                            {
+                                return arg.data == block;
+                            }))
+                    {
+                        blocks[i].resize(count);
+                        block = blocks[i].data();
+                    }
+
+                    apply_block(
+                        inst.op, args.data(), args.size(), block, count);
+
+                    if (i + 1 == num_instructions && block != out + first)
+                    {
+                        std::copy(block, block + count, out + first);
+                    }
+                    values[i].data = block;
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Execute the program block by block, the shapes of all values are
+        // known to be compatible.
+        primitive_result_type execute_fused(operands_type && ops,
+            std::vector<fused_instruction> const& program,
+            std::vector<shape_type> const& shapes)
+        {
+            std::size_t const num_instructions = program.size();
+
+            // find an array operand determining the shape of the result
+            operand_type const* ref = nullptr;
+            for (operand_type const& op : ops)
+            {
+                if (op.num_dimensions() != 0)
+                {
+                    ref = &op;
+                    break;
+                }
+            }
+
+            std::vector<fused_value> values(num_instructions);
+            std::vector<fused_value> args;
+
+            // compute all 0-dimensional values up front
+            for (std::size_t i = 0; i != num_instructions; ++i)
+            {
+                fused_instruction const& inst = program[i];
+                fused_value& value = values[i];
+                value.data = nullptr;
+
+                if (!shapes[i].empty())
+                {
+                    continue;
+                }
+
+                if (inst.op == opcode::load)
+                {
+                    value.scalar = ops[inst.args[0]][0];
+                    continue;
+                }
+
+                args.clear();
+                for (std::size_t arg : inst.args)
+                {
+                    args.push_back(values[arg]);
+                }
+                value.scalar = apply_scalar(inst.op, args.data(), args.size());
+            }
+
+            if (ref == nullptr)
+            {
+                return primitive_result_type(
+                    operand_type(values.back().scalar));
+            }
+
+            // the result is computed in place, no intermediate array needs
+            // to be allocated. An operand of the same shape which is not
+            // referenced anywhere else (an intermediate value or the value of
+            // a variable used for the last time) is overwritten.
+            operand_type* donor = nullptr;
+            for (std::size_t i = 0; i != num_instructions; ++i)
+            {
+                if (program[i].op == opcode::load &&
+                    shapes[i] == shapes.back())
+                {
+                    operand_type& op = ops[program[i].args[0]];
+                    if (!op.is_shared() && !op.is_view())
+                    {
+                        donor = &op;
+                        break;
+                    }
+                }
+            }
+
+            operand_type result;
+            if (donor == nullptr)
+            {
+                result = operand_type(ref->dimensions());
+            }
+            double* out = (donor != nullptr) ? donor->data() : result.data();
+
+            // chunks of large arrays are processed concurrently, each of
+            // them block by block
+            detail::for_each_chunk(std::ptrdiff_t(ref->size()),
+                [&](std::ptrdiff_t chunk_first, std::ptrdiff_t chunk_count)
+                {
+                    execute_blocks(ops, program, shapes, values, out,
+                        chunk_first, chunk_first + chunk_count);
+                });
+
+            if (donor != nullptr)
+            {
+                return primitive_result_type(std::move(*donor));
+            }
+            if (shapes.back().size() > 2)
+            {
+                return primitive_result_type(result.reshape(shapes.back()));
+            }
+            return primitive_result_type(std::move(result));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Execute the program by applying the original operations one after
+        // the other.
+        primitive_result_type execute_unfused(operands_type && ops,
+            std::vector<fused_instruction> const& program)
+        {
+            operands_type values;
+            values.reserve(program.size());
+
+            for (fused_instruction const& inst : program)
+            {
+                if (inst.op == opcode::load)
+                {
+                    values.push_back(std::move(ops[inst.args[0]]));
+                    continue;
+                }
+
+                operands_type args;
+                args.reserve(inst.args.size());
+                for (std::size_t arg : inst.args)
+                {
+                    args.push_back(std::move(values[arg]));
+                }
+
+                switch (inst.op)
+                {
+                case opcode::add:
+                    values.push_back(extract_numeric_value(
+                        add_operation::apply(std::move(args))));
+                    break;
+
+                case opcode::sub:
+                    values.push_back(extract_numeric_value(
+                        sub_operation::apply(std::move(args))));
+                    break;
+
+                case opcode::mul:
+                    values.push_back(extract_numeric_value(
+                        mul_operation::apply(std::move(args))));
+                    break;
+
+                case opcode::div:
+                    values.push_back(extract_numeric_value(
+                        div_operation::apply(std::move(args))));
+                    break;
+
+                case opcode::negate:
+                    values.push_back(extract_numeric_value(
+                        unary_minus_operation::apply(std::move(args))));
+                    break;
+
+                case opcode::exp:
+                    values.push_back(extract_numeric_value(
+                        exponential_operation::apply(std::move(args))));
+                    break;
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "fused_operation::apply",
+                        "unknown instruction in fused program");
+                }
+            }
+
+            return primitive_result_type(std::move(values.back()));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool fused_operation::elementwise_shape(fused_instruction const& inst,
+        std::vector<shape_type> const& shapes, shape_type& result)
+    {
+        return detail::elementwise_shape(inst, shapes, result);
+    }
+
+    primitive_result_type fused_operation::apply(operands_type && ops,
+        std::vector<fused_instruction> const& program)
+    {
+        // determine the shapes of all values, bail out to the original
+        // operations if any of them would not be element-wise
+        std::vector<detail::shape_type> shapes(program.size());
+
+        bool fusible = true;
+        for (std::size_t i = 0; fusible && i != program.size(); ++i)
+        {
+            fused_instruction const& inst = program[i];
+            if (inst.op == detail::opcode::load)
+            {
+                operand_type& op = ops[inst.args[0]];
+                if (op.is_sparse())
+                {
+                    fusible = false;
+                    break;
+                }
+                op = op.contiguous();
+                shapes[i] = op.shape();
+                continue;
+            }
+
+            fusible = detail::elementwise_shape(inst, shapes, shapes[i]);
+        }
+
+        if (!fusible)
+        {
+            return detail::execute_unfused(std::move(ops), program);
+        }
+        return detail::execute_fused(std::move(ops), program, shapes);
+    }
+
+    primitive_result_type fused_operation::apply(operands_type && ops,
+        std::vector<fused_instruction> const& program,
+        std::vector<shape_type> const& shapes)
+    {
+        // the shapes of the intermediate values follow from the shapes of
+        // the operands, fall back to determining them if the operands
+        // don't have the expected shapes
+        for (std::size_t i = 0; i != program.size(); ++i)
+        {
+            fused_instruction const& inst = program[i];
+            if (inst.op != detail::opcode::load)
+            {
+                continue;
+            }
+
+            operand_type& op = ops[inst.args[0]];
+            if (op.is_sparse() || op.shape() != shapes[i])
+            {
+                return apply(std::move(ops), program);
+            }
+            op = op.contiguous();
+        }
+
+        return detail::execute_fused(std::move(ops), program, shapes);
+    }
+
+    hpx::future<primitive_result_type> fused_operation::eval() const
+    {
+        return hpx::dataflow(hpx::util::unwrapping(
+            [this](operands_type&& ops) -> primitive_result_type
+            {
+                if (shapes_.empty())
+                {
+                    return apply(std::move(ops), program_);
+                }
+                return apply(std::move(ops), program_, shapes_);
+            }),
+            detail::map_operands(operands_, numeric_operand)
+        );
+    }
+}}}
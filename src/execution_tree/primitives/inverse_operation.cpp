@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/execution_tree/primitives/detail/blas_backend.hpp>
 #include <phylanx/execution_tree/primitives/inverse_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/serialization/eigen.hpp>
@@ -111,7 +112,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 using matrix_type =
                     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>;
 
-                matrix_type result = ops[0].matrix().inverse();
+                operand_type const& op = ops[0];
+                matrix_type result;
+                if (!lapack_inverse(op.matrix(), result))
+                {
+                    result = op.matrix().inverse();
+                }
                 return ir::node_data<double>(std::move(result));
             }
 
@@ -0,0 +1,51 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/last_use.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::last_use>
+    last_use_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(last_use_type,
+    phylanx_last_use_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(last_use_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    last_use::last_use(std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+    {
+        if (operands_.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "last_use::last_use",
+                "the last_use primitive requires exactly one operand");
+        }
+
+        if (!is_primitive_operand(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "last_use::last_use",
+                "the argument of the last_use primitive must refer to "
+                    "another primitive and can't be a literal value");
+        }
+    }
+
+    hpx::future<primitive_result_type> last_use::eval() const
+    {
+        return primitive_operand(operands_[0]).eval_last_use();
+    }
+}}}
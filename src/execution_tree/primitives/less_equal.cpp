@@ -4,6 +4,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/typed_elementwise.hpp>
 #include <phylanx/execution_tree/primitives/less_equal.hpp>
 #include <phylanx/ir/node_data.hpp>
 
@@ -65,139 +66,46 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {}
 
         protected:
-            using operand_type = ir::node_data<double>;
             using operands_type = std::vector<primitive_result_type>;
 
-            bool less_equal0d(operand_type&& lhs, operand_type&& rhs) const
-            {
-                std::size_t rhs_dims = rhs.num_dimensions();
-                switch(rhs_dims)
-                {
-                case 0:
-                    return lhs[0] <= rhs[0];
-
-                case 1: HPX_FALLTHROUGH;
-                case 2: HPX_FALLTHROUGH;
-                default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "less_equal::less_equal0d",
-                        "the operands have incompatible number of dimensions");
-                }
-            }
-
-            bool less_equal1d1d(operand_type&& lhs, operand_type&& rhs) const
-            {
-                std::size_t lhs_size = lhs.dimension(0);
-                std::size_t rhs_size = rhs.dimension(0);
-
-                if (lhs_size != rhs_size)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "less_equal::less_equal1d1d",
-                        "the dimensions of the operands do not match");
-                }
-
-                lhs.matrix().array() =
-                    (lhs.matrix().array() <= rhs.matrix().array())
-                        .cast<double>();
-
-                return lhs.matrix().norm() != 0.0;
-            }
-
-            bool less_equal1d(operand_type&& lhs, operand_type&& rhs) const
-            {
-                std::size_t rhs_dims = rhs.num_dimensions();
-                switch(rhs_dims)
-                {
-                case 1:
-                    return less_equal1d1d(std::move(lhs), std::move(rhs));
-
-                case 0: HPX_FALLTHROUGH;
-                case 2: HPX_FALLTHROUGH;
-                default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "less_equal::less_equal1d",
-                        "the operands have incompatible number of dimensions");
-                }
-            }
-
-            bool less_equal2d2d(operand_type&& lhs, operand_type&& rhs) const
+            struct visit_less_equal
             {
-                auto lhs_size = lhs.dimensions();
-                auto rhs_size = rhs.dimensions();
-
-                if (lhs_size != rhs_size)
+                template <typename T1, typename T2>
+                primitive_result_type operator()(T1, T2) const
                 {
                     HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "less_equal::less_equal2d2d",
-                        "the dimensions of the operands do not match");
+                        "less_equal::eval",
+                        "left hand side and right hand side are incompatible "
+                            "and can't be compared");
                 }
 
-                lhs.matrix().array() =
-                    (lhs.matrix().array() <= rhs.matrix().array()).cast<double>();
-
-                return lhs.matrix().norm() != 0.0;
-            }
-
-            bool less_equal2d(operand_type&& lhs, operand_type&& rhs) const
-            {
-                std::size_t rhs_dims = rhs.num_dimensions();
-                switch(rhs_dims)
+                template <typename T>
+                primitive_result_type operator()(T && lhs, T && rhs) const
                 {
-                case 2:
-                    return less_equal2d2d(std::move(lhs), std::move(rhs));
-
-                case 0: HPX_FALLTHROUGH;
-                case 1: HPX_FALLTHROUGH;
-                default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "less_equal::less_equal2d",
-                        "the operands have incompatible number of dimensions");
+                    return primitive_result_type(lhs <= rhs);
                 }
-            }
 
-        public:
-            bool less_equal_all(operand_type&& lhs, operand_type&& rhs) const
-            {
-                std::size_t lhs_dims = lhs.num_dimensions();
-                switch (lhs_dims)
+                // arrays are compared in their promoted element type, the
+                // result is a mask unless both operands are 0-dimensional
+                template <typename T>
+                primitive_result_type operator()(
+                    ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const
                 {
-                case 0:
-                    return less_equal0d(std::move(lhs), std::move(rhs));
-
-                case 1:
-                    return less_equal1d(std::move(lhs), std::move(rhs));
-
-                case 2:
-                    return less_equal2d(std::move(lhs), std::move(rhs));
-
-                default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "less_equal::less_equal_all",
-                        "left hand side operand has unsupported number of "
-                        "dimensions");
+                    return compare_elements(typed_operation::less_equal,
+                        primitive_result_type(std::move(lhs)),
+                        primitive_result_type(std::move(rhs)), "less_equal::eval");
                 }
-            }
 
-        protected:
-            struct visit_less_equal
-            {
                 template <typename T1, typename T2>
-                bool operator()(T1, T2) const
+                primitive_result_type operator()(
+                    ir::node_data<T1>&& lhs, ir::node_data<T2>&& rhs) const
                 {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "less_equal::eval",
-                        "left hand side and right hand side are incompatible "
-                            "and can't be compared");
+                    return compare_elements(typed_operation::less_equal,
+                        primitive_result_type(std::move(lhs)),
+                        primitive_result_type(std::move(rhs)), "less_equal::eval");
                 }
 
-                template <typename T>
-                bool operator()(T && lhs, T && rhs) const
-                {
-                    return lhs <= rhs;
-                }
-
-                bool operator()(
+                primitive_result_type operator()(
                     ir::node_data<double>&& lhs, std::int64_t&& rhs) const
                 {
                     if (lhs.num_dimensions() != 0)
@@ -207,10 +115,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "left hand side and right hand side are "
                                 "incompatible and can't be compared");
                     }
-                    return lhs[0] <= rhs;
+                    return primitive_result_type(lhs[0] <= rhs);
                 }
 
-                bool operator()(
+                primitive_result_type operator()(
                     std::int64_t&& lhs, ir::node_data<double>&& rhs) const
                 {
                     if (rhs.num_dimensions() != 0)
@@ -220,27 +128,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "left hand side and right hand side are "
                                 "incompatible and can't be compared");
                     }
-                    return lhs <= rhs[0];
+                    return primitive_result_type(lhs <= rhs[0]);
                 }
-
-                bool operator()(operand_type&& lhs, operand_type&& rhs) const
-                {
-                    return less_equal_.less_equal_all(std::move(lhs), std::move(rhs));
-                }
-
-                less_equal const& less_equal_;
             };
 
         public:
             hpx::future<primitive_result_type> eval() const
             {
-                auto this_ = this->shared_from_this();
                 return hpx::dataflow(hpx::util::unwrapping(
-                    [this_](operands_type && ops)
+                    [](operands_type && ops) -> primitive_result_type
                     {
-                        return primitive_result_type(
-                            util::visit(visit_less_equal{*this_},
-                                std::move(ops[0]), std::move(ops[1])));
+                        return util::visit(visit_less_equal{},
+                            std::move(ops[0]), std::move(ops[1]));
                     }),
                     detail::map_operands(operands_, literal_operand)
                 );
@@ -0,0 +1,86 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/loop_invariant.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::loop_invariant>
+    loop_invariant_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(loop_invariant_type,
+    phylanx_loop_invariant_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(loop_invariant_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    loop_invariant::loop_invariant(
+            std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+    {
+        if (operands_.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "loop_invariant::loop_invariant",
+                "the loop_invariant primitive requires exactly one operand");
+        }
+
+        if (!valid(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "loop_invariant::loop_invariant",
+                "the loop_invariant primitive requires that the argument "
+                    "given by the operands array is valid");
+        }
+    }
+
+    hpx::future<primitive_result_type> loop_invariant::eval() const
+    {
+        hpx::shared_future<primitive_result_type> value;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            value = value_;
+        }
+
+        if (!value.valid())
+        {
+            // the operand is evaluated without holding the lock as it might
+            // be evaluated directly
+            value = literal_operand(operands_[0]).share();
+
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!value_.valid())
+            {
+                value_ = value;
+            }
+        }
+
+        if (value.is_ready() && value.has_value())
+        {
+            return hpx::make_ready_future(value.get());
+        }
+        return value.then(
+            [](hpx::shared_future<primitive_result_type> && f)
+            {
+                return f.get();
+            });
+    }
+
+    void loop_invariant::store(primitive_result_type const&)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        value_ = hpx::shared_future<primitive_result_type>();
+    }
+}}}
@@ -0,0 +1,156 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/blocked_factorizations.hpp>
+#include <phylanx/execution_tree/primitives/lu_decompose.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/eigen.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::lu_decompose>
+    lu_decompose_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    lu_decompose_type, phylanx_lu_decompose_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(lu_decompose_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const lu_decompose::match_data =
+    {
+        hpx::util::make_tuple(
+            "lu_decompose", "lu_decompose(_1)", &create<lu_decompose>),
+        hpx::util::make_tuple(
+            "lu_decompose", "lu_decompose(_1, _2)", &create<lu_decompose>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    lu_decompose::lu_decompose(std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+    {
+        if (operands_.size() != 1 && operands_.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "lu_decompose::lu_decompose",
+                "the lu_decompose primitive requires one or two operands");
+        }
+
+        if (!valid(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "lu_decompose::lu_decompose",
+                "the lu_decompose primitive requires that the argument "
+                    "given by the operands array is valid");
+        }
+
+        if (operands_.size() == 2)
+        {
+            std::string* part = util::get_if<std::string>(&operands_[1]);
+            if (part == nullptr ||
+                (*part != "L" && *part != "U" && *part != "P"))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "lu_decompose::lu_decompose",
+                    "the second argument of the lu_decompose primitive "
+                        "must be one of \"L\", \"U\", or \"P\"");
+            }
+
+            part_ = std::move(*part);
+            operands_.pop_back();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct blocked_lu_decomposition
+          : std::enable_shared_from_this<blocked_lu_decomposition>
+        {
+            blocked_lu_decomposition(
+                    std::vector<primitive_argument_type> const& operands,
+                    std::string const& part)
+              : operands_(operands)
+              , part_(part)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        if (ops[0].num_dimensions() != 2)
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "lu_decompose::eval",
+                                "the lu_decompose primitive requires a "
+                                    "matrix");
+                        }
+                        return this_->lu2d(std::move(ops));
+                    }),
+                    detail::map_operands(operands_, numeric_operand)
+                );
+            }
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+
+            primitive_result_type lu2d(operands_type && ops) const
+            {
+                matrix_type lu = ops[0].matrix();
+                std::ptrdiff_t const rows = lu.rows();
+                std::ptrdiff_t const cols = lu.cols();
+                std::ptrdiff_t const steps = (std::min)(rows, cols);
+
+                std::vector<std::ptrdiff_t> pivots;
+                blocked_lu(lu, pivots);
+
+                if (part_ == "L")
+                {
+                    matrix_type result = lu.leftCols(steps)
+                        .triangularView<Eigen::UnitLower>();
+                    return operand_type(std::move(result));
+                }
+                if (part_ == "U")
+                {
+                    matrix_type result = lu.topRows(steps)
+                        .triangularView<Eigen::Upper>();
+                    return operand_type(std::move(result));
+                }
+                if (part_ == "P")
+                {
+                    return operand_type(lu_permutation(pivots, rows));
+                }
+                return operand_type(std::move(lu));
+            }
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+            std::string part_;
+        };
+    }
+
+    hpx::future<primitive_result_type> lu_decompose::eval() const
+    {
+        return std::make_shared<detail::blocked_lu_decomposition>(
+            operands_, part_)->eval();
+    }
+}}}
@@ -0,0 +1,180 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/factorization_cache.hpp>
+#include <phylanx/execution_tree/primitives/lu_factorization.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/eigen.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::lu_factorization>
+    lu_factorization_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    lu_factorization_type, phylanx_lu_factorization_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(lu_factorization_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const lu_factorization::match_data =
+    {
+        hpx::util::make_tuple("lu", "lu(_1)", &create<lu_factorization>),
+        hpx::util::make_tuple("lu", "lu(_1, _2)", &create<lu_factorization>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    lu_factorization::lu_factorization(
+            std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+    {
+        if (operands_.size() != 1 && operands_.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "lu_factorization::lu_factorization",
+                "the lu_factorization primitive requires one or two "
+                    "operands");
+        }
+
+        if (!valid(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "lu_factorization::lu_factorization",
+                "the lu_factorization primitive requires that the "
+                    "argument given by the operands array is valid");
+        }
+
+        if (operands_.size() == 2)
+        {
+            std::string* part = util::get_if<std::string>(&operands_[1]);
+            if (part == nullptr ||
+                (*part != "L" && *part != "U" && *part != "P"))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "lu_factorization::lu_factorization",
+                    "the second argument of the lu_factorization primitive "
+                        "must be one of \"L\", \"U\", or \"P\"");
+            }
+
+            part_ = std::move(*part);
+            operands_.pop_back();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct lu : std::enable_shared_from_this<lu>
+        {
+            lu(std::vector<primitive_argument_type> const& operands,
+                    std::string const& part)
+              : operands_(operands)
+              , part_(part)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        std::size_t dims = ops[0].num_dimensions();
+                        switch (dims)
+                        {
+                        case 0:
+                            return this_->lu0d(std::move(ops));
+
+                        case 2:
+                            return this_->lu2d(std::move(ops));
+
+                        default:
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "lu_factorization::eval",
+                                "left hand side operand has unsupported "
+                                    "number of dimensions");
+                        }
+                    }),
+                    detail::map_operands(operands_, numeric_operand)
+                );
+            }
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+            using matrix_type = operand_type::storage_type;
+
+            primitive_result_type lu0d(operands_type && ops) const
+            {
+                if (part_ == "L" || part_ == "P")
+                {
+                    return operand_type(1.0);
+                }
+                return std::move(ops[0]);
+            }
+
+            primitive_result_type lu2d(operands_type && ops) const
+            {
+                operand_type const& op = ops[0];
+
+                auto dims = op.dimensions();
+                if (dims[0] != dims[1])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "lu_factorization::lu2d",
+                        "the lu_factorization primitive requires a "
+                            "quadratic matrix");
+                }
+
+                // the decomposition is shared with solve and determinant
+                std::shared_ptr<lu_type const> decomposition =
+                    cached_lu(operands_[0], op);
+
+                matrix_type result;
+                if (part_ == "L")
+                {
+                    result = decomposition->matrixLU()
+                        .triangularView<Eigen::UnitLower>();
+                }
+                else if (part_ == "U")
+                {
+                    result = decomposition->matrixLU()
+                        .triangularView<Eigen::Upper>();
+                }
+                else if (part_ == "P")
+                {
+                    result = decomposition->permutationP() *
+                        matrix_type::Identity(dims[0], dims[1]);
+                }
+                else
+                {
+                    result = decomposition->matrixLU();
+                }
+                return operand_type(std::move(result));
+            }
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+            std::string part_;
+        };
+    }
+
+    hpx::future<primitive_result_type> lu_factorization::eval() const
+    {
+        return std::make_shared<detail::lu>(operands_, part_)->eval();
+    }
+}}}
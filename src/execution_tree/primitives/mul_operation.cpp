@@ -5,6 +5,8 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/matrix_product.hpp>
+#include <phylanx/execution_tree/primitives/detail/typed_elementwise.hpp>
 #include <phylanx/execution_tree/primitives/mul_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/optional.hpp>
@@ -69,7 +71,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    ir::node_data<double> mul_operation::mul0d(operands_type && ops) const
+    ir::node_data<double> mul_operation::mul0d(operands_type && ops)
     {
         operand_type& lhs = ops[0];
         operand_type& rhs = ops[1];
@@ -106,6 +108,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "is not a matrix");
                 }
 
+                if (rhs.is_sparse())
+                {
+                    rhs.sparse_matrix() *= lhs[0];
+                    return std::move(rhs);
+                }
+
                 rhs.matrix() = lhs[0] * rhs.matrix();
                 return std::move(rhs);
             }
@@ -118,63 +126,272 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    ir::node_data<double> mul_operation::mulxd(operands_type && ops) const
+    namespace detail
+    {
+        // multiply two operands, the product of sparse operands stays sparse,
+        // a product involving a dense matrix is dense
+        ir::node_data<double> mul_sparse(
+            ir::node_data<double>&& lhs, ir::node_data<double> const& rhs)
+        {
+            using matrix_type = ir::node_data<double>::storage_type;
+            using sparse_matrix_type =
+                ir::node_data<double>::sparse_storage_type;
+
+            if (rhs.num_dimensions() == 0)
+            {
+                if (lhs.is_sparse())
+                {
+                    lhs.sparse_matrix() *= rhs[0];
+                }
+                else
+                {
+                    lhs.matrix() *= rhs[0];
+                }
+                return std::move(lhs);
+            }
+
+            ir::node_data<double> const& clhs = lhs;
+            if (rhs.is_sparse())
+            {
+                if (clhs.is_sparse())
+                {
+                    return ir::node_data<double>(sparse_matrix_type(
+                        clhs.sparse_matrix() * rhs.sparse_matrix()));
+                }
+                return ir::node_data<double>(
+                    matrix_type(clhs.matrix() * rhs.sparse_matrix()));
+            }
+            return ir::node_data<double>(
+                matrix_type(clhs.sparse_matrix() * rhs.matrix()));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Multiplication of a chain of dense matrices, the products are
+        // evaluated in the order requiring the least number of scalar
+        // multiplications (for instance, A * B * v is computed as
+        // A * (B * v)).
+        class matrix_chain
+        {
+        public:
+            using matrix_type = ir::node_data<double>::storage_type;
+
+            // the operands are the (dense) matrices of the chain in order
+            matrix_chain(std::vector<ir::node_data<double> const*>&& operands)
+              : operands_(std::move(operands))
+              , split_(operands_.size(),
+                    std::vector<std::size_t>(operands_.size(), 0))
+            {
+                std::size_t const n = operands_.size();
+
+                // the i-th matrix has dims[i] rows and dims[i + 1] columns
+                std::vector<double> dims(n + 1);
+                dims[0] = double(operands_[0]->dimensions()[0]);
+                for (std::size_t i = 0; i != n; ++i)
+                {
+                    if (i != 0 &&
+                        operands_[i - 1]->dimensions()[1] !=
+                            operands_[i]->dimensions()[0])
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "mul_operation::mulxd",
+                            "the dimensions of the operands do not match");
+                    }
+                    dims[i + 1] = double(operands_[i]->dimensions()[1]);
+                }
+
+                // cost[i][j]: the least number of multiplications needed for
+                // the product of the matrices i to j
+                std::vector<std::vector<double>> cost(
+                    n, std::vector<double>(n, 0.0));
+
+                for (std::size_t length = 1; length != n; ++length)
+                {
+                    for (std::size_t i = 0; i + length != n; ++i)
+                    {
+                        std::size_t const j = i + length;
+
+                        cost[i][j] = -1.0;
+                        for (std::size_t k = i; k != j; ++k)
+                        {
+                            double const c = cost[i][k] + cost[k + 1][j] +
+                                dims[i] * dims[k + 1] * dims[j + 1];
+                            if (cost[i][j] < 0.0 || c < cost[i][j])
+                            {
+                                cost[i][j] = c;
+                                split_[i][j] = k;
+                            }
+                        }
+                    }
+                }
+            }
+
+            matrix_type product() const
+            {
+                return product(0, operands_.size() - 1);
+            }
+
+        private:
+            // the product of the matrices i to j (i < j), the operands are
+            // used directly instead of copying them
+            matrix_type product(std::size_t i, std::size_t j) const
+            {
+                std::size_t const k = split_[i][j];
+                if (k == i)
+                {
+                    if (k + 1 == j)
+                    {
+                        return matrix_product(
+                            operands_[i]->matrix(), operands_[j]->matrix());
+                    }
+                    return matrix_product(
+                        operands_[i]->matrix(), product(k + 1, j));
+                }
+
+                if (k + 1 == j)
+                {
+                    return matrix_product(
+                        product(i, k), operands_[j]->matrix());
+                }
+                return matrix_product(product(i, k), product(k + 1, j));
+            }
+
+            std::vector<ir::node_data<double> const*> operands_;
+            std::vector<std::vector<std::size_t>> split_;
+        };
+
+        // Multiply a chain of at least 3 dense matrices and any number of
+        // scalars, return false if the operands are not such a chain.
+        bool mul_chain(std::vector<ir::node_data<double>> const& ops,
+            ir::node_data<double>& result)
+        {
+            std::vector<ir::node_data<double> const*> matrices;
+            matrices.reserve(ops.size());
+
+            double factor = 1.0;
+            bool scaled = false;
+
+            for (auto const& op : ops)
+            {
+                if (op.is_sparse() || op.num_dimensions() > 2)
+                {
+                    return false;
+                }
+
+                if (op.num_dimensions() == 0)
+                {
+                    factor *= op[0];
+                    scaled = true;
+                }
+                else
+                {
+                    matrices.push_back(&op);
+                }
+            }
+
+            if (matrices.size() < 3)
+            {
+                return false;
+            }
+
+            matrix_chain::matrix_type product =
+                matrix_chain(std::move(matrices)).product();
+            if (scaled)
+            {
+                product *= factor;
+            }
+
+            result = ir::node_data<double>(std::move(product));
+            return true;
+        }
+    }
+
+    ir::node_data<double> mul_operation::mulxd(operands_type && ops)
     {
         operand_type& lhs = ops[0];
-        operand_type& rhs = ops[1];
+        operand_type const& rhs = ops[1];
 
         if (ops.size() == 2)
         {
+            if (lhs.is_sparse() || rhs.is_sparse())
+            {
+                return detail::mul_sparse(std::move(lhs), rhs);
+            }
+
             if (rhs.num_dimensions() == 0)
             {
                 lhs.matrix() *= rhs[0];
                 return std::move(lhs);
             }
 
-            lhs.matrix() *= rhs.matrix();
-            return std::move(lhs);
+            operand_type const& clhs = lhs;
+            return operand_type(
+                detail::matrix_product(clhs.matrix(), rhs.matrix()));
+        }
+
+        ir::node_data<double> result;
+        if (detail::mul_chain(ops, result))
+        {
+            return result;
         }
 
         return std::accumulate(
             ops.begin() + 1, ops.end(), std::move(lhs),
             [](operand_type& result, operand_type const& curr) -> operand_type
             {
-                if (curr.num_dimensions() == 0)
+                if (result.is_sparse() || curr.is_sparse())
                 {
-                    result.matrix() *= curr[0];
+                    return detail::mul_sparse(std::move(result), curr);
                 }
-                else
+
+                if (curr.num_dimensions() == 0)
                 {
-                    result.matrix() *= curr.matrix();
+                    result.matrix() *= curr[0];
+                    return std::move(result);
                 }
-                return std::move(result);
+
+                operand_type const& cresult = result;
+                return operand_type(
+                    detail::matrix_product(cresult.matrix(), curr.matrix()));
             });
     }
 
     // implement '*' for all possible combinations of lhs and rhs
+    primitive_result_type mul_operation::apply(operands_type && ops)
+    {
+        std::size_t lhs_dims = ops[0].num_dimensions();
+        switch (lhs_dims)
+        {
+        case 0:
+            return primitive_result_type(mul0d(std::move(ops)));
+
+        case 1: HPX_FALLTHROUGH;
+        case 2:
+            return primitive_result_type(mulxd(std::move(ops)));
+
+        default:
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "mul_operation::eval",
+                "left hand side operand has unsupported number of "
+                "dimensions");
+        }
+    }
+
     hpx::future<primitive_result_type> mul_operation::eval() const
     {
         return hpx::dataflow(hpx::util::unwrapping(
-            [this](operands_type&& ops) -> primitive_result_type
+            [](std::vector<primitive_result_type>&& ops)
+            ->  primitive_result_type
             {
-                std::size_t lhs_dims = ops[0].num_dimensions();
-                switch (lhs_dims)
+                if (detail::is_typed_operation(
+                        detail::typed_operation::mul, ops))
                 {
-                case 0:
-                    return primitive_result_type(mul0d(std::move(ops)));
-
-                case 1: HPX_FALLTHROUGH;
-                case 2:
-                    return primitive_result_type(mulxd(std::move(ops)));
-
-                default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "mul_operation::eval",
-                        "left hand side operand has unsupported number of "
-                        "dimensions");
+                    return detail::typed_elementwise(
+                        detail::typed_operation::mul, std::move(ops),
+                        "mul_operation::eval");
                 }
+                return apply(detail::numeric_values(std::move(ops)));
             }),
-            detail::map_operands(operands_, numeric_operand)
+            detail::map_operands(operands_, literal_operand)
         );
     }
 }}}
@@ -0,0 +1,144 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/blocked_factorizations.hpp>
+#include <phylanx/execution_tree/primitives/qr_decompose.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/eigen.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::qr_decompose>
+    qr_decompose_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    qr_decompose_type, phylanx_qr_decompose_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(qr_decompose_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const qr_decompose::match_data =
+    {
+        hpx::util::make_tuple(
+            "qr_decompose", "qr_decompose(_1)", &create<qr_decompose>),
+        hpx::util::make_tuple(
+            "qr_decompose", "qr_decompose(_1, _2)", &create<qr_decompose>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    qr_decompose::qr_decompose(std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+    {
+        if (operands_.size() != 1 && operands_.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "qr_decompose::qr_decompose",
+                "the qr_decompose primitive requires one or two operands");
+        }
+
+        if (!valid(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "qr_decompose::qr_decompose",
+                "the qr_decompose primitive requires that the argument "
+                    "given by the operands array is valid");
+        }
+
+        if (operands_.size() == 2)
+        {
+            std::string* part = util::get_if<std::string>(&operands_[1]);
+            if (part == nullptr || (*part != "Q" && *part != "R"))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "qr_decompose::qr_decompose",
+                    "the second argument of the qr_decompose primitive "
+                        "must be either \"Q\" or \"R\"");
+            }
+
+            part_ = std::move(*part);
+            operands_.pop_back();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct blocked_qr_decomposition
+          : std::enable_shared_from_this<blocked_qr_decomposition>
+        {
+            blocked_qr_decomposition(
+                    std::vector<primitive_argument_type> const& operands,
+                    std::string const& part)
+              : operands_(operands)
+              , part_(part)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        if (ops[0].num_dimensions() != 2)
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "qr_decompose::eval",
+                                "the qr_decompose primitive requires a "
+                                    "matrix");
+                        }
+                        return this_->qr2d(std::move(ops));
+                    }),
+                    detail::map_operands(operands_, numeric_operand)
+                );
+            }
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+
+            primitive_result_type qr2d(operands_type && ops) const
+            {
+                matrix_type qr = ops[0].matrix();
+                std::ptrdiff_t const steps = (std::min)(qr.rows(), qr.cols());
+
+                std::vector<double> tau;
+                blocked_qr(qr, tau);
+
+                if (part_ == "Q")
+                {
+                    return operand_type(qr_thin_q(qr, tau));
+                }
+
+                matrix_type result =
+                    qr.topRows(steps).triangularView<Eigen::Upper>();
+                return operand_type(std::move(result));
+            }
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+            std::string part_;
+        };
+    }
+
+    hpx::future<primitive_result_type> qr_decompose::eval() const
+    {
+        return std::make_shared<detail::blocked_qr_decomposition>(
+            operands_, part_)->eval();
+    }
+}}}
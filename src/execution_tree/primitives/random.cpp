@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/execution_tree/primitives/detail/counter_based_random.hpp>
 #include <phylanx/execution_tree/primitives/random.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/serialization/eigen.hpp>
@@ -15,7 +16,9 @@
 
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -36,27 +39,64 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     std::vector<match_pattern_type> const random::match_data =
     {
-        hpx::util::make_tuple("random", "random(_1)", &create<random>)
+        hpx::util::make_tuple("random", "random(_1)", &create<random>),
+        hpx::util::make_tuple("random", "random(_1, _2)", &create<random>),
+        hpx::util::make_tuple(
+            "random", "random(_1, _2, _3)", &create<random>),
+        hpx::util::make_tuple(
+            "random", "random(_1, _2, _3, _4)", &create<random>),
+        hpx::util::make_tuple(
+            "random", "random(_1, _2, _3, _4, _5)", &create<random>)
     };
 
     ///////////////////////////////////////////////////////////////////////////
     random::random(std::vector<primitive_argument_type>&& operands)
       : operands_(std::move(operands))
+      , distribution_("uniform")
     {
-        if (operands_.size() > 1)
+        if (operands_.empty() || operands_.size() > 5)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "random::random",
-                "the random primitive requires"
-                    "at most one operand");
+                "the random primitive requires between one and five "
+                    "operands");
+        }
+
+        for (auto const& operand : operands_)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "random::random",
+                    "the random primitive requires that the "
+                        "arguments given by the operands array are valid");
+            }
+        }
+
+        if (operands_.size() > 1)
+        {
+            std::string* distribution =
+                util::get_if<std::string>(&operands_[1]);
+            if (distribution == nullptr ||
+                (*distribution != "uniform" && *distribution != "normal" &&
+                    *distribution != "bernoulli"))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "random::random",
+                    "the second argument of the random primitive must be "
+                        "one of \"uniform\", \"normal\", or \"bernoulli\"");
+            }
+
+            distribution_ = std::move(*distribution);
+            operands_.erase(operands_.begin() + 1);
         }
 
-        if (!valid(operands_[0]))
+        if (operands_.size() == 4 && distribution_ != "bernoulli")
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "random::random",
-                "the random primitive requires that the "
-                    "arguments given by the operands array are valid");
+                "the random primitive accepts a probability for the "
+                    "bernoulli distribution only");
         }
     }
 
@@ -65,9 +105,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         struct random : std::enable_shared_from_this<random>
         {
-            random(std::vector<primitive_argument_type> const& operands)
+            random(std::vector<primitive_argument_type> const& operands,
+                    std::string const& distribution)
               : operands_(operands)
-            {}
+              , distribution_(random_distribution::uniform)
+            {
+                if (distribution == "normal")
+                {
+                    distribution_ = random_distribution::normal;
+                }
+                else if (distribution == "bernoulli")
+                {
+                    distribution_ = random_distribution::bernoulli;
+                }
+            }
 
             hpx::future<primitive_result_type> eval()
             {
@@ -75,12 +126,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 return hpx::dataflow(hpx::util::unwrapping(
                     [this_](operands_type&& ops) -> primitive_result_type
                     {
-                        std::size_t dims = 0;
-                        if (!ops.empty())
-                        {
-                            dims = ops[0].num_dimensions();
-                        }
-
+                        std::size_t dims = ops[0].num_dimensions();
                         switch (dims)
                         {
                         case 0:
@@ -107,9 +153,65 @@ namespace phylanx { namespace execution_tree { namespace primitives
             using operand_type = ir::node_data<double>;
             using operands_type = std::vector<operand_type>;
 
+            // seeds and streams are non-negative integral scalars
+            static std::uint64_t extract_integer(
+                operand_type const& op, char const* name)
+            {
+                if (op.num_dimensions() != 0 || op[0] < 0.0 ||
+                    op[0] != std::floor(op[0]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "random::eval",
+                        std::string("the ") + name + " of the random "
+                            "primitive must be a non-negative integer");
+                }
+                return std::uint64_t(op[0]);
+            }
+
+            // Without an explicit seed every evaluation draws from a new
+            // stream, without an explicit stream the first stream of the
+            // given seed is used.
+            void fill(operands_type const& ops, double* data,
+                std::ptrdiff_t size) const
+            {
+                std::uint64_t seed = 0;
+                std::uint64_t stream = 0;
+                if (ops.size() > 1)
+                {
+                    seed = extract_integer(ops[1], "seed");
+                    if (ops.size() > 2)
+                    {
+                        stream = extract_integer(ops[2], "stream");
+                    }
+                }
+                else
+                {
+                    stream = next_random_stream();
+                }
+
+                double probability = 0.5;
+                if (ops.size() > 3)
+                {
+                    if (ops[3].num_dimensions() != 0 || ops[3][0] < 0.0 ||
+                        ops[3][0] > 1.0)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "random::eval",
+                            "the probability of the bernoulli distribution "
+                                "must be a scalar in [0, 1]");
+                    }
+                    probability = ops[3][0];
+                }
+
+                fill_random(
+                    data, size, distribution_, seed, stream, probability);
+            }
+
             primitive_result_type random0d(operands_type && ops) const
             {
-                return std::move(ops[0]);       // no-op
+                double result = 0.0;
+                fill(ops, &result, 1);
+                return operand_type(result);
             }
 
             primitive_result_type random1d(operands_type && ops) const
@@ -118,7 +220,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 using vector_type = Eigen::Matrix<double, Eigen::Dynamic, 1>;
 
-                vector_type result = Eigen::VectorXd::Random(dim);
+                vector_type result(dim);
+                fill(ops, result.data(), dim);
                 return operand_type(std::move(result));
             }
 
@@ -129,17 +232,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 using matrix_type =
                     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>;
 
-                matrix_type result = Eigen::MatrixXd::Random(dim[0], dim[1]);
+                matrix_type result(dim[0], dim[1]);
+                fill(ops, result.data(), dim[0] * dim[1]);
                 return operand_type(std::move(result));
             }
 
         private:
             std::vector<primitive_argument_type> operands_;
+            random_distribution distribution_;
         };
     }
 
     hpx::future<primitive_result_type> random::eval() const
     {
-        return std::make_shared<detail::random>(operands_)->eval();
+        return std::make_shared<detail::random>(operands_, distribution_)
+            ->eval();
     }
 }}}
@@ -0,0 +1,233 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/blas_backend.hpp>
+#include <phylanx/execution_tree/primitives/detail/factorization_cache.hpp>
+#include <phylanx/execution_tree/primitives/detail/matrix_product.hpp>
+#include <phylanx/execution_tree/primitives/solve_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/eigen.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::solve_operation>
+    solve_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    solve_operation_type, phylanx_solve_operation_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(solve_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // dot(inverse(A), b) is solve(A, b, "inverse")
+        primitive create_inverse_product(hpx::id_type locality,
+            std::vector<primitive_argument_type>&& operands, variables&,
+            functions&)
+        {
+            operands.emplace_back(std::string("inverse"));
+            return primitive(
+                hpx::new_<solve_operation>(locality, std::move(operands)));
+        }
+    }
+
+    std::vector<match_pattern_type> const solve_operation::match_data =
+    {
+        hpx::util::make_tuple(
+            "solve", "solve(_1, _2)", &create<solve_operation>),
+        hpx::util::make_tuple(
+            "solve", "solve(_1, _2, _3)", &create<solve_operation>),
+        // avoid computing the inverse of a matrix only to multiply it
+        hpx::util::make_tuple(
+            "solve", "dot(inverse(_1), _2)", &create_inverse_product)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    solve_operation::solve_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : operands_(std::move(operands))
+      , method_("lu")
+    {
+        if (operands_.size() != 2 && operands_.size() != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "solve_operation::solve_operation",
+                "the solve_operation primitive requires two or three "
+                    "operands");
+        }
+
+        if (!valid(operands_[0]) || !valid(operands_[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "solve_operation::solve_operation",
+                "the solve_operation primitive requires that the "
+                    "arguments given by the operands array are valid");
+        }
+
+        if (operands_.size() == 3)
+        {
+            std::string* method = util::get_if<std::string>(&operands_[2]);
+            if (method == nullptr ||
+                (*method != "lu" && *method != "cholesky" &&
+                    *method != "inverse"))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "solve_operation::solve_operation",
+                    "the third argument of the solve_operation primitive "
+                        "must be one of \"lu\", \"cholesky\", or "
+                        "\"inverse\"");
+            }
+
+            method_ = std::move(*method);
+            operands_.pop_back();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct solve : std::enable_shared_from_this<solve>
+        {
+            solve(std::vector<primitive_argument_type> const& operands,
+                    std::string const& method)
+              : operands_(operands)
+              , method_(method)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        std::size_t dims = ops[0].num_dimensions();
+                        switch (dims)
+                        {
+                        case 0:
+                            return this_->solve0d(std::move(ops));
+
+                        case 2:
+                            return this_->solve2d(std::move(ops));
+
+                        default:
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "solve_operation::eval",
+                                "left hand side operand has unsupported "
+                                    "number of dimensions");
+                        }
+                    }),
+                    detail::map_operands(operands_, numeric_operand)
+                );
+            }
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+            using matrix_type = operand_type::storage_type;
+
+            primitive_result_type solve0d(operands_type && ops) const
+            {
+                if (method_ == "inverse")
+                {
+                    // this is dot(inverse(a), b)
+                    if (ops[1].num_dimensions() != 0)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "solve_operation::solve0d",
+                            "the operands have incompatible number of "
+                                "dimensions");
+                    }
+                    return operand_type((1 / ops[0][0]) * ops[1][0]);
+                }
+
+                double const lhs = ops[0][0];
+                if (ops[1].num_dimensions() == 0)
+                {
+                    return operand_type(ops[1][0] / lhs);
+                }
+
+                ops[1].matrix() /= lhs;
+                return std::move(ops[1]);
+            }
+
+            primitive_result_type solve2d(operands_type && ops) const
+            {
+                operand_type const& lhs = ops[0];
+                operand_type const& rhs = ops[1];
+
+                auto lhs_dims = lhs.dimensions();
+                if (lhs_dims[0] != lhs_dims[1])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "solve_operation::solve2d",
+                        "the solve_operation primitive requires a quadratic "
+                            "matrix");
+                }
+
+                if (rhs.num_dimensions() == 0 ||
+                    rhs.dimensions()[0] != lhs_dims[0])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "solve_operation::solve2d",
+                        "the number of rows of the right hand side does not "
+                            "match the size of the matrix");
+                }
+
+                // the decomposition of the matrix is reused for as long as
+                // its value doesn't change
+                matrix_type result;
+                if (method_ == "cholesky")
+                {
+                    result =
+                        cached_cholesky(operands_[0], lhs)->solve(rhs.matrix());
+                }
+                else
+                {
+                    std::shared_ptr<lu_type const> decomposition =
+                        cached_lu(operands_[0], lhs);
+
+                    // dot(inverse(A), b) is computed as written if A is
+                    // singular, the result is not meaningful either way
+                    if (method_ == "inverse" && decomposition->is_singular())
+                    {
+                        matrix_type inverse;
+                        if (!lapack_inverse(lhs.matrix(), inverse))
+                        {
+                            inverse = lhs.matrix().inverse();
+                        }
+                        return operand_type(
+                            matrix_product(inverse, rhs.matrix()));
+                    }
+
+                    result = decomposition->solve(rhs.matrix());
+                }
+                return operand_type(std::move(result));
+            }
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+            std::string method_;
+        };
+    }
+
+    hpx::future<primitive_result_type> solve_operation::eval() const
+    {
+        return std::make_shared<detail::solve>(operands_, method_)->eval();
+    }
+}}}
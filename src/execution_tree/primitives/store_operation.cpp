@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/execution_tree/primitives/detail/factorization_cache.hpp>
 #include <phylanx/execution_tree/primitives/store_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/optional.hpp>
@@ -87,6 +88,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         {
                             primitive_operand(this_->operands_[0])
                                 .store(hpx::launch::sync, val);
+
+                            // the decompositions of the old value are stale
+                            invalidate_factorizations(this_->operands_[0]);
                             return std::move(val);
                         }));
             }
@@ -4,6 +4,9 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/combine_elements.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
+#include <phylanx/execution_tree/primitives/detail/typed_elementwise.hpp>
 #include <phylanx/execution_tree/primitives/sub_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/optional.hpp>
@@ -14,6 +17,7 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <numeric>
@@ -83,7 +87,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_result_type sub0d0d(operands_type && ops) const
             {
                 operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
+                operand_type const& rhs = ops[1];
 
                 if (ops.size() == 2)
                 {
@@ -111,7 +115,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a vector only if there are exactly 2 operands");
                 }
 
-                ops[1].matrix().array() = ops[0][0] - ops[1].matrix().array();
+                double const value = ops[0][0];
+                transform(ops[1],
+                    [value](array_segment const& x)
+                    {
+                        return value - x;
+                    });
                 return primitive_result_type(std::move(ops[1]));
             }
 
@@ -125,7 +134,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a matrix only if there are exactly 2 operands");
                 }
 
-                ops[1].matrix().array() = ops[0][0] - ops[1].matrix().array();
+                double const value = ops[0][0];
+                transform(ops[1],
+                    [value](array_segment const& x)
+                    {
+                        return value - x;
+                    });
+                return primitive_result_type(std::move(ops[1]));
+            }
+
+            primitive_result_type sub0dnd(operands_type && ops) const
+            {
+                if (ops.size() != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "sub_operation::sub0dnd",
+                        "the sub_operation primitive can sub a single value "
+                            "to an array only if there are exactly 2 operands");
+                }
+
+                double const value = ops[0][0];
+                transform(ops[1],
+                    [value](array_segment const& x)
+                    {
+                        return value - x;
+                    });
                 return primitive_result_type(std::move(ops[1]));
             }
 
@@ -144,9 +177,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     return sub0d2d(std::move(ops));
 
                 default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "sub_operation::sub0d",
-                        "the operands have incompatible number of dimensions");
+                    return sub0dnd(std::move(ops));
                 }
             }
 
@@ -161,19 +192,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a vector only if there are exactly 2 operands");
                 }
 
-                ops[0].matrix().array() -= ops[1][0];
+                double const value = ops[1][0];
+                transform(ops[0],
+                    [value](array_segment const& x)
+                    {
+                        return x - value;
+                    });
                 return primitive_result_type(std::move(ops[0]));
             }
 
             primitive_result_type sub1d1d(operands_type && ops) const
             {
                 operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
-
-                std::size_t lhs_size = lhs.dimension(0);
-                std::size_t rhs_size = rhs.dimension(0);
+                operand_type const& rhs = ops[1];
 
-                if (lhs_size != rhs_size)
+                auto lhs_size = lhs.dimensions();
+                if (std::any_of(ops.begin() + 1, ops.end(),
+                        [&](operand_type const& op)
+                        {
+                            return op.dimensions() != lhs_size;
+                        }))
                 {
                     HPX_THROW_EXCEPTION(hpx::bad_parameter,
                         "sub_operation::sub1d1d",
@@ -182,18 +220,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 if (ops.size() == 2)
                 {
-                    lhs.matrix().array() -= rhs.matrix().array();
+                    transform(lhs, rhs,
+                        [](array_segment const& x, const_array_segment const& y)
+                        {
+                            return x - y;
+                        });
                     return primitive_result_type(std::move(lhs));
                 }
 
-                operand_type& first_term = *ops.begin();
-                return primitive_result_type(std::accumulate(
-                    ops.begin() + 1, ops.end(), std::move(first_term),
-                    [](operand_type& result, operand_type const& curr) -> operand_type
-                    {
-                        result.matrix().array() -= curr.matrix().array();
-                        return std::move(result);
-                    }));
+                return primitive_result_type(combine_elements(
+                    elementwise_operation::sub, std::move(ops)));
             }
 
             primitive_result_type sub1d(operands_type && ops) const
@@ -227,19 +263,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "to a matrix only if there are exactly 2 operands");
                 }
 
-                ops[0].matrix().array() -= ops[1][0];
+                double const value = ops[1][0];
+                transform(ops[0],
+                    [value](array_segment const& x)
+                    {
+                        return x - value;
+                    });
                 return primitive_result_type(std::move(ops[0]));
             }
 
             primitive_result_type sub2d2d(operands_type && ops) const
             {
                 operand_type& lhs = ops[0];
-                operand_type& rhs = ops[1];
+                operand_type const& rhs = ops[1];
 
                 auto lhs_size = lhs.dimensions();
-                auto rhs_size = rhs.dimensions();
-
-                if (lhs_size != rhs_size)
+                if (std::any_of(ops.begin() + 1, ops.end(),
+                        [&](operand_type const& op)
+                        {
+                            return op.dimensions() != lhs_size;
+                        }))
                 {
                     HPX_THROW_EXCEPTION(hpx::bad_parameter,
                         "sub_operation::sub2d2d",
@@ -248,19 +291,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 if (ops.size() == 2)
                 {
-                    lhs.matrix().array() -= rhs.matrix().array();
+                    transform(lhs, rhs,
+                        [](array_segment const& x, const_array_segment const& y)
+                        {
+                            return x - y;
+                        });
                     return primitive_result_type(std::move(lhs));
                 }
 
-                operand_type& first_term = *ops.begin();
-                return primitive_result_type(std::accumulate(
-                    ops.begin() + 1, ops.end(), std::move(first_term),
-                    [](operand_type& result, operand_type const& curr)
-                    ->  operand_type
-                    {
-                        result.matrix().array() -= curr.matrix().array();
-                        return std::move(result);
-                    }));
+                return primitive_result_type(combine_elements(
+                    elementwise_operation::sub, std::move(ops)));
             }
 
             primitive_result_type sub2d(operands_type && ops) const
@@ -282,33 +322,113 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 }
             }
 
+            ///////////////////////////////////////////////////////////////////////////
+            primitive_result_type subnd0d(operands_type && ops) const
+            {
+                if (ops.size() != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "sub_operation::subnd0d",
+                        "the sub_operation primitive can sub a single value "
+                            "to an array only if there are exactly 2 operands");
+                }
+
+                double const value = ops[1][0];
+                transform(ops[0],
+                    [value](array_segment const& x)
+                    {
+                        return x - value;
+                    });
+                return primitive_result_type(std::move(ops[0]));
+            }
+
+            primitive_result_type subndnd(operands_type && ops) const
+            {
+                operand_type& lhs = ops[0];
+
+                auto lhs_shape = lhs.shape();
+                for (auto it = ops.begin() + 1; it != ops.end(); ++it)
+                {
+                    if (it->shape() != lhs_shape)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "sub_operation::subndnd",
+                            "the dimensions of the operands do not match");
+                    }
+                }
+
+                // all operands are contiguous and have the same shape, thus
+                // their elements can be combined using their 2-dimensional
+                // representation
+                if (ops.size() == 2)
+                {
+                    operand_type const& rhs = ops[1];
+                    transform(lhs, rhs,
+                        [](array_segment const& x, const_array_segment const& y)
+                        {
+                            return x - y;
+                        });
+                    return primitive_result_type(std::move(lhs));
+                }
+
+                return primitive_result_type(combine_elements(
+                    elementwise_operation::sub, std::move(ops)));
+            }
+
+            primitive_result_type subnd(operands_type && ops) const
+            {
+                std::size_t lhs_dims = ops[0].num_dimensions();
+                std::size_t rhs_dims = ops[1].num_dimensions();
+
+                if (rhs_dims == 0)
+                {
+                    return subnd0d(std::move(ops));
+                }
+                if (rhs_dims == lhs_dims)
+                {
+                    return subndnd(std::move(ops));
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "sub_operation::subnd",
+                    "the operands have incompatible number of dimensions");
+            }
+
         public:
+            primitive_result_type compute(operands_type && ops) const
+            {
+                std::size_t lhs_dims = ops[0].num_dimensions();
+                switch (lhs_dims)
+                {
+                case 0:
+                    return sub0d(std::move(ops));
+
+                case 1:
+                    return sub1d(std::move(ops));
+
+                case 2:
+                    return sub2d(std::move(ops));
+
+                default:
+                    return subnd(std::move(ops));
+                }
+            }
+
             hpx::future<primitive_result_type> eval() const
             {
                 auto this_ = this->shared_from_this();
                 return hpx::dataflow(hpx::util::unwrapping(
-                    [this_](operands_type && ops) -> primitive_result_type
+                    [this_](std::vector<primitive_result_type> && ops)
+                    ->  primitive_result_type
                     {
-                        std::size_t lhs_dims = ops[0].num_dimensions();
-                        switch (lhs_dims)
+                        if (is_typed_operation(typed_operation::sub, ops))
                         {
-                        case 0:
-                            return this_->sub0d(std::move(ops));
-
-                        case 1:
-                            return this_->sub1d(std::move(ops));
-
-                        case 2:
-                            return this_->sub2d(std::move(ops));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "sub_operation::eval",
-                                "left hand side operand has unsupported "
-                                    "number of dimensions");
+                            return typed_elementwise(typed_operation::sub,
+                                std::move(ops), "sub_operation::eval");
                         }
+                        return this_->compute(numeric_values(std::move(ops)));
                     }),
-                    detail::map_operands(operands_, numeric_operand)
+                    detail::map_operands(operands_, literal_operand)
                 );
             }
 
@@ -322,4 +442,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         return std::make_shared<detail::sub>(operands_)->eval();
     }
+
+    primitive_result_type sub_operation::apply(
+        std::vector<ir::node_data<double>>&& ops)
+    {
+        detail::sub op{std::vector<primitive_argument_type>{}};
+        return op.compute(std::move(ops));
+    }
 }}}
@@ -109,6 +109,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             primitive_result_type transposexd(operands_type && ops) const
             {
+                if (ops[0].is_sparse())
+                {
+                    operand_type const& op = ops[0];
+                    return operand_type(operand_type::sparse_storage_type(
+                        op.sparse_matrix().transpose()));
+                }
+
                 ops[0].matrix().transposeInPlace();
                 return std::move(ops[0]);
             }
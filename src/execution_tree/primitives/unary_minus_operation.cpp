@@ -3,8 +3,9 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
-#include <phylanx/config.hpp>
 #include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/parallel_elementwise.hpp>
 #include <phylanx/execution_tree/primitives/unary_minus_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/optional.hpp>
@@ -83,32 +84,35 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             primitive_result_type negxd(operands_type&& ops) const
             {
-                ops[0].matrix().array() = -ops[0].matrix().array();
+                transform(ops[0],
+                    [](array_segment const& x)
+                    {
+                        return -x;
+                    });
                 return primitive_result_type(std::move(ops[0]));
             }
 
         public:
+            primitive_result_type compute(operands_type && ops) const
+            {
+                std::size_t lhs_dims = ops[0].num_dimensions();
+                switch (lhs_dims)
+                {
+                case 0:
+                    return neg0d(std::move(ops));
+
+                default:
+                    return negxd(std::move(ops));
+                }
+            }
+
             hpx::future<primitive_result_type> eval() const
             {
                 auto this_ = this->shared_from_this();
                 return hpx::dataflow(hpx::util::unwrapping(
                     [this_](operands_type && ops) -> primitive_result_type
                     {
-                        std::size_t lhs_dims = ops[0].num_dimensions();
-                        switch (lhs_dims)
-                        {
-                        case 0:
-                            return this_->neg0d(std::move(ops));
-
-                        case 1: HPX_FALLTHROUGH;
-                        case 2:
-                            return this_->negxd(std::move(ops));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "unary_minus_operation::eval",
-                                "operand has unsupported number of dimensions");
-                        }
+                        return this_->compute(std::move(ops));
                     }),
                     detail::map_operands(operands_, numeric_operand)
                 );
@@ -124,4 +128,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         return std::make_shared<detail::unary_minus>(operands_)->eval();
     }
+
+    primitive_result_type unary_minus_operation::apply(
+        std::vector<ir::node_data<double>>&& ops)
+    {
+        detail::unary_minus op{std::vector<primitive_argument_type>{}};
+        return op.compute(std::move(ops));
+    }
 }}}
@@ -9,6 +9,8 @@
 #include <hpx/include/components.hpp>
 #include <hpx/include/lcos.hpp>
 
+#include <utility>
+
 ///////////////////////////////////////////////////////////////////////////////
 typedef hpx::components::component<
     phylanx::execution_tree::primitives::variable>
@@ -71,9 +73,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return hpx::make_ready_future(data_);
     }
 
+    hpx::future<primitive_result_type> variable::eval_last_use()
+    {
+        // moving the value out allows the caller to modify it in place
+        primitive_result_type data = std::move(data_);
+        data_ = primitive_result_type{};
+        return hpx::make_ready_future(std::move(data));
+    }
+
     void variable::store(primitive_result_type const& data)
     {
         data_ = data;
+        increment_store_generation();
     }
 }}}
 
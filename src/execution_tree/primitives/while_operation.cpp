@@ -60,6 +60,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
     }
 
+    while_operation::while_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::vector<primitive_argument_type>&& invariants)
+      : while_operation(std::move(operands))
+    {
+        for (auto const& invariant : invariants)
+        {
+            if (!is_primitive_operand(invariant))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::while_operation::"
+                        "while_operation",
+                    "the loop invariants of the while_operation primitive "
+                        "must be primitives");
+            }
+        }
+        invariants_ = std::move(invariants);
+    }
+
     namespace detail
     {
         struct iteration : std::enable_shared_from_this<iteration>
@@ -111,6 +130,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
     // start iteration over given while statement
     hpx::future<primitive_result_type> while_operation::eval() const
     {
+        // the loop invariants are evaluated at most once per execution of
+        // the loop
+        for (auto const& invariant : invariants_)
+        {
+            primitive_operand(invariant).store(
+                hpx::launch::sync, primitive_result_type{});
+        }
+
         return std::make_shared<detail::iteration>(operands_)->loop();
     }
 }}}
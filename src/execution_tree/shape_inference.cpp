@@ -0,0 +1,356 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/shape_inference.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    static_shape shape_of(primitive_argument_type const& value)
+    {
+        switch (value.index())
+        {
+        case 1: HPX_FALLTHROUGH;    // bool
+        case 2:                     // std::int64_t
+            return static_shape(ir::node_data<double>::shape_type{});
+
+        case 4:     // phylanx::ir::node_data<double>
+            return static_shape(util::get<4>(value).shape());
+
+        case 5:     // phylanx::ir::node_data<float>
+            return static_shape(util::get<5>(value).shape());
+
+        case 6:     // phylanx::ir::node_data<std::int64_t>
+            return static_shape(util::get<6>(value).shape());
+
+        case 7:     // phylanx::ir::node_data<std::uint8_t>
+            return static_shape(util::get<7>(value).shape());
+
+        default:
+            break;
+        }
+        return static_shape();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using shape_type = ir::node_data<double>::shape_type;
+
+        // vectors are treated as column vectors, as by the primitives
+        std::ptrdiff_t rows(shape_type const& shape)
+        {
+            return shape.empty() ? 1 : shape[0];
+        }
+
+        std::ptrdiff_t cols(shape_type const& shape)
+        {
+            return shape.size() < 2 ? 1 : shape[1];
+        }
+
+        // shape of a matrix value with the given extents
+        shape_type make_shape(std::ptrdiff_t rows, std::ptrdiff_t cols)
+        {
+            if (cols != 1)
+            {
+                return shape_type{rows, cols};
+            }
+            if (rows != 1)
+            {
+                return shape_type{rows};
+            }
+            return shape_type{};
+        }
+
+        [[noreturn]] void shape_error(
+            std::string const& name, std::string const& msg)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::infer_shape",
+                "the " + name + " primitive rejects its operands: " + msg);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // add, sub, and div
+        shape_type elementwise_shape(
+            std::string const& name, std::vector<shape_type> const& ops)
+        {
+            shape_type const& lhs = ops[0];
+            shape_type const& rhs = ops[1];
+
+            if (lhs.empty() && rhs.empty())
+            {
+                return shape_type{};
+            }
+
+            if (lhs.empty() || rhs.empty())
+            {
+                if (ops.size() != 2)
+                {
+                    shape_error(name, "a single value can be combined with "
+                        "an array only if there are exactly 2 operands");
+                }
+                return lhs.empty() ? rhs : lhs;
+            }
+
+            if (lhs.size() != rhs.size())
+            {
+                shape_error(name,
+                    "the operands have incompatible number of dimensions");
+            }
+
+            if (std::any_of(ops.begin() + 1, ops.end(),
+                    [&](shape_type const& shape) { return shape != lhs; }))
+            {
+                shape_error(
+                    name, "the dimensions of the operands do not match");
+            }
+            return lhs;
+        }
+
+        static_shape mul_shape(std::vector<shape_type> const& ops)
+        {
+            shape_type const& lhs = ops[0];
+            if (lhs.empty())
+            {
+                shape_type const& rhs = ops[1];
+                if (rhs.empty())
+                {
+                    return static_shape(shape_type{});
+                }
+                if (rhs.size() > 2)
+                {
+                    shape_error("mul",
+                        "the operands have incompatible number of dimensions");
+                }
+                if (ops.size() != 2)
+                {
+                    shape_error("mul", "can't handle more than 2 operands "
+                        "when first operand is not a matrix");
+                }
+                return static_shape(rhs);
+            }
+
+            if (lhs.size() > 2)
+            {
+                shape_error("mul", "left hand side operand has unsupported "
+                    "number of dimensions");
+            }
+
+            // the products are computed in place, the shape of the result is
+            // known only if it doesn't change
+            shape_type const& result = lhs;
+            for (auto it = ops.begin() + 1; it != ops.end(); ++it)
+            {
+                if (it->empty())
+                {
+                    continue;
+                }
+                if (it->size() > 2 || cols(result) != rows(*it))
+                {
+                    shape_error("mul",
+                        "the dimensions of the operands do not match");
+                }
+
+                if (make_shape(rows(result), cols(*it)) != result)
+                {
+                    return static_shape();
+                }
+            }
+            return static_shape(result);
+        }
+
+        static_shape dot_shape(std::vector<shape_type> const& ops)
+        {
+            shape_type const& lhs = ops[0];
+            shape_type const& rhs = ops[1];
+
+            switch (lhs.size())
+            {
+            case 0:
+                if (!rhs.empty())
+                {
+                    break;
+                }
+                return static_shape(shape_type{});
+
+            case 1:
+                if (rhs.empty() || rhs.size() > 2 ||
+                    rows(lhs) != rows(rhs) * cols(rhs) ||
+                    (rhs.size() == 2 && rows(rhs) == 1 &&
+                        rows(lhs) != cols(rhs)))
+                {
+                    break;
+                }
+                return static_shape(shape_type{});
+
+            case 2:
+                if (rhs.empty() || rhs.size() > 2 || cols(lhs) != rows(rhs))
+                {
+                    break;
+                }
+                return static_shape(make_shape(rows(lhs), cols(rhs)));
+
+            default:
+                shape_error("dot", "left hand side operand has unsupported "
+                    "number of dimensions");
+            }
+
+            shape_error("dot",
+                "the operands have incompatible number of dimensions");
+        }
+
+        static_shape solve_shape(std::vector<shape_type> const& ops)
+        {
+            shape_type const& lhs = ops[0];
+            shape_type const& rhs = ops[1];
+
+            if (lhs.empty())
+            {
+                return static_shape(rhs);
+            }
+
+            if (lhs.size() != 2 || rows(lhs) != cols(lhs))
+            {
+                shape_error("solve", "the matrix is not quadratic");
+            }
+
+            if (rhs.empty() || rhs.size() > 2 || rows(rhs) != rows(lhs))
+            {
+                shape_error("solve", "the number of rows of the right hand "
+                    "side does not match the size of the matrix");
+            }
+            return static_shape(rhs);
+        }
+
+        // cholesky and lu
+        static_shape factorization_shape(
+            std::string const& name, shape_type const& op)
+        {
+            if (op.size() == 1 || op.size() > 2 ||
+                (op.size() == 2 && rows(op) != cols(op)))
+            {
+                shape_error(name, "the matrix is not quadratic");
+            }
+            return static_shape(op);
+        }
+
+        static_shape exp_shape(shape_type const& op)
+        {
+            if (op.size() == 1 || (op.size() == 2 && rows(op) != cols(op)))
+            {
+                shape_error("exp",
+                    "matrix exponentiation requires quadratic matrices");
+            }
+            return static_shape(op);
+        }
+
+        static_shape transpose_shape(shape_type const& op)
+        {
+            switch (op.size())
+            {
+            case 0:
+                return static_shape(shape_type{});
+
+            case 2:
+                return static_shape(make_shape(cols(op), rows(op)));
+
+            case 1:
+                return static_shape();
+
+            default:
+                break;
+            }
+
+            shape_error("transpose", "left hand side operand has unsupported "
+                "number of dimensions");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    static_shape infer_shape(std::string const& name,
+        std::vector<static_shape> const& operands)
+    {
+        // the primitives themselves report a wrong number of operands
+        std::vector<detail::shape_type> ops;
+        ops.reserve(operands.size());
+        for (static_shape const& operand : operands)
+        {
+            if (!operand)
+            {
+                return static_shape();
+            }
+            ops.push_back(*operand);
+        }
+
+        if (name == "add" || name == "sub" || name == "div")
+        {
+            if (ops.size() < 2)
+            {
+                return static_shape();
+            }
+            return static_shape(detail::elementwise_shape(name, ops));
+        }
+
+        if (name == "mul")
+        {
+            if (ops.size() < 2)
+            {
+                return static_shape();
+            }
+            return detail::mul_shape(ops);
+        }
+
+        if (name == "dot")
+        {
+            if (ops.size() != 2)
+            {
+                return static_shape();
+            }
+            return detail::dot_shape(ops);
+        }
+
+        if (name == "solve")
+        {
+            if (ops.size() != 2)
+            {
+                return static_shape();
+            }
+            return detail::solve_shape(ops);
+        }
+
+        if (ops.size() != 1)
+        {
+            return static_shape();
+        }
+
+        if (name == "unary_minus")
+        {
+            return static_shape(ops[0]);
+        }
+        if (name == "exp")
+        {
+            return detail::exp_shape(ops[0]);
+        }
+        if (name == "cholesky" || name == "lu")
+        {
+            return detail::factorization_shape(name, ops[0]);
+        }
+        if (name == "transpose")
+        {
+            return detail::transpose_shape(ops[0]);
+        }
+        return static_shape();
+    }
+}}
@@ -8,14 +8,23 @@
 
 #include <hpx/exception.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 namespace phylanx { namespace ir
 {
     namespace detail
     {
+        std::uint64_t next_array_identity()
+        {
+            static std::atomic<std::uint64_t> identity(1);
+            return identity++;
+        }
+
         template <typename Range>
         void print_array(std::ostream& out, Range const& r, std::size_t size)
         {
@@ -30,61 +39,134 @@ namespace phylanx { namespace ir
             }
             out << "]";
         }
-    }
 
-    ///////////////////////////////////////////////////////////////////////////
-    std::ostream& operator<<(std::ostream& out, node_data<double> const& nd)
-    {
-        std::size_t dims = nd.num_dimensions();
-        switch (dims)
+        template <typename Matrix>
+        void print_matrix(std::ostream& out, Matrix const& data)
         {
-        case 0:
-            out << std::to_string(nd[0]);
-            break;
+            for (std::ptrdiff_t row = 0; row != data.rows(); ++row)
+            {
+                if (row != 0)
+                    out << ", ";
+                print_array(out, data.row(row), data.cols());
+            }
+        }
 
-        case 1:
-            detail::print_array(out, nd, nd.size());
-            break;
+        // print N-dimensional arrays as nested lists of matrices, the last
+        // axis being the outermost one
+        template <typename T>
+        void print_tensor(std::ostream& out, T const* data,
+            std::vector<std::ptrdiff_t> const& shape, std::size_t dim)
+        {
+            using matrix_type = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
 
-        case 2:
+            if (dim == 1)
             {
-                auto const& data = nd.matrix();
-                for (std::size_t row = 0; row != data.rows(); ++row)
-                {
-                    if (row != 0)
-                        out << ", ";
-                    detail::print_array(out, data.row(row), data.cols());
-                }
+                print_matrix(out,
+                    Eigen::Map<matrix_type const>(data, shape[0], shape[1]));
+                return;
+            }
+
+            std::ptrdiff_t stride = 1;
+            for (std::size_t i = 0; i != dim; ++i)
+            {
+                stride *= shape[i];
+            }
+
+            for (std::ptrdiff_t i = 0; i != shape[dim]; ++i)
+            {
+                if (i != 0)
+                    out << ", ";
+                out << "[";
+                print_tensor(out, data + i * stride, shape, dim - 1);
+                out << "]";
+            }
+        }
+
+        template <typename T>
+        std::ostream& print_node_data(std::ostream& out, node_data<T> const& d)
+        {
+            node_data<T> const nd = d.contiguous();
+
+            std::size_t dims = nd.num_dimensions();
+            switch (dims)
+            {
+            case 0:
+                out << std::to_string(nd[0]);
+                break;
+
+            case 1:
+                print_array(out, nd, nd.size());
+                break;
+
+            case 2:
+                print_matrix(out, nd.matrix());
+                break;
+
+            default:
+                print_tensor(out, nd.data(), nd.shape(), dims - 1);
+                break;
             }
-            break;
+            return out;
+        }
 
-        default:
-            HPX_THROW_EXCEPTION(hpx::invalid_status,
-                "node_data<double>::operator bool",
-                "invalid dimensionality: " + std::to_string(dims));
+        template <typename T>
+        bool node_data_to_bool(node_data<T> const& d)
+        {
+            node_data<T> const nd = d.contiguous();
+
+            if (nd.num_dimensions() == 0)
+            {
+                return nd[0] != T(0);
+            }
+            return (nd.matrix().array() != T(0)).any();
         }
-        return out;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::ostream& operator<<(std::ostream& out, node_data<double> const& nd)
+    {
+        return detail::print_node_data(out, nd);
+    }
+
+    std::ostream& operator<<(std::ostream& out, node_data<float> const& nd)
+    {
+        return detail::print_node_data(out, nd);
+    }
+
+    std::ostream& operator<<(
+        std::ostream& out, node_data<std::int64_t> const& nd)
+    {
+        return detail::print_node_data(out, nd);
+    }
+
+    std::ostream& operator<<(
+        std::ostream& out, node_data<std::uint8_t> const& nd)
+    {
+        return detail::print_node_data(out, nd);
     }
 
     ///////////////////////////////////////////////////////////////////////////
     template <>
     node_data<double>::operator bool() const
     {
-        std::size_t dims = num_dimensions();
-        switch (dims)
-        {
-        case 0:
-            HPX_FALLTHROUGH;
-        case 1:
-            HPX_FALLTHROUGH;
-        case 2:
-            return matrix().norm() != 0;
-
-        default:
-            HPX_THROW_EXCEPTION(hpx::invalid_status,
-                "node_data<double>::operator bool",
-                "invalid dimensionality: " + std::to_string(dims));
-        }
-        return false;
+        return detail::node_data_to_bool(*this);
+    }
+
+    template <>
+    node_data<float>::operator bool() const
+    {
+        return detail::node_data_to_bool(*this);
+    }
+
+    template <>
+    node_data<std::int64_t>::operator bool() const
+    {
+        return detail::node_data_to_bool(*this);
+    }
+
+    template <>
+    node_data<std::uint8_t>::operator bool() const
+    {
+        return detail::node_data_to_bool(*this);
     }
 }}
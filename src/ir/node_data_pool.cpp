@@ -0,0 +1,44 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace phylanx { namespace ir
+{
+    namespace detail
+    {
+        static std::atomic<std::uint64_t> node_data_pool_hits(0);
+        static std::atomic<std::uint64_t> node_data_pool_misses(0);
+
+        void count_node_data_pool_access(bool hit)
+        {
+            if (hit)
+            {
+                node_data_pool_hits.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                node_data_pool_misses.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    node_data_pool_statistics get_node_data_pool_statistics(bool reset)
+    {
+        if (reset)
+        {
+            return node_data_pool_statistics{
+                detail::node_data_pool_hits.exchange(0),
+                detail::node_data_pool_misses.exchange(0)};
+        }
+        return node_data_pool_statistics{
+            detail::node_data_pool_hits.load(),
+            detail::node_data_pool_misses.load()};
+    }
+}}
@@ -9,6 +9,10 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 void test_generate_tree(std::string const& exprstr,
     phylanx::execution_tree::pattern_list const& patterns,
     phylanx::execution_tree::variables const& variables,
@@ -353,6 +357,169 @@ void test_if_conditional()
 */
 }
 
+void test_deeply_nested_expression()
+{
+    phylanx::execution_tree::pattern_list patterns = {
+        phylanx::execution_tree::primitives::add_operation::match_data
+    };
+
+    phylanx::execution_tree::variables variables = {
+        {"B", create_literal_value(1.0)}
+    };
+
+    // nesting deeper than the limit of directly evaluated primitives
+    std::string expr = "B";
+    for (int i = 0; i != 100; ++i)
+    {
+        expr = "B + (" + expr + ")";
+    }
+    test_generate_tree(expr, patterns, variables, 101.0);
+}
+
+void test_constant_folding()
+{
+    phylanx::execution_tree::pattern_list patterns = {
+        phylanx::execution_tree::primitives::add_operation::match_data,
+        phylanx::execution_tree::primitives::block_operation::match_data,
+        phylanx::execution_tree::primitives::constant::match_data,
+        phylanx::execution_tree::primitives::define_::match_data,
+        phylanx::execution_tree::primitives::mul_operation::match_data,
+        phylanx::execution_tree::primitives::store_operation::match_data,
+        phylanx::execution_tree::primitives::unary_minus_operation::match_data
+    };
+
+    phylanx::execution_tree::variables variables = {
+        {"A", create_literal_value(41.0)}
+    };
+
+    // subexpressions of literals only are evaluated while generating the tree
+    test_generate_tree("2.0 * 3.0", patterns, variables, 6.0);
+    test_generate_tree("A + 2.0 * 3.0", patterns, variables, 47.0);
+    test_generate_tree("-(1.0 + 2.0) + A", patterns, variables, 38.0);
+    test_generate_tree("constant(42.0, 3)", patterns, variables, 42.0);
+
+    // folded values can still be used as variables
+    test_generate_tree("block(define(x, 2.0 * 3.0), store(x, x + A), x)",
+        patterns, variables, 47.0);
+}
+
+void test_register_patterns()
+{
+    phylanx::execution_tree::register_patterns({
+        hpx::util::make_tuple("plus", "plus(_1, _2)",
+            &phylanx::execution_tree::create<
+                phylanx::execution_tree::primitives::add_operation>)
+    });
+
+    phylanx::execution_tree::variables variables = {
+        {"A", create_literal_value(41.0)},
+        {"B", create_literal_value(1.0)}
+    };
+
+    phylanx::execution_tree::primitive_argument_type p =
+        phylanx::execution_tree::generate_tree("plus(A, B)", variables);
+    HPX_TEST_EQ(
+        phylanx::execution_tree::numeric_operand(p).get()[0], 42.0);
+
+    // function invocations are still matched last
+    phylanx::execution_tree::pattern_list patterns =
+        phylanx::execution_tree::get_all_known_patterns();
+    HPX_TEST(hpx::util::get<0>(patterns.back()[0]) == "any_function");
+}
+
+void test_pattern_index()
+{
+    using phylanx::execution_tree::create;
+
+    phylanx::execution_tree::variables variables = {
+        {"A", create_literal_value(2.0)},
+        {"B", create_literal_value(3.0)},
+        {"C", create_literal_value(4.0)}
+    };
+
+    // operator patterns are selected by the operator of the expression
+    phylanx::execution_tree::pattern_list operators = {
+        phylanx::execution_tree::primitives::add_operation::match_data,
+        phylanx::execution_tree::primitives::mul_operation::match_data,
+        phylanx::execution_tree::primitives::unary_minus_operation::match_data
+    };
+
+    test_generate_tree("A * B * C", operators, variables, 24.0);
+    test_generate_tree("A * (B + C)", operators, variables, 14.0);
+    test_generate_tree("(A + B) * C", operators, variables, 20.0);
+    test_generate_tree("-(A * B)", operators, variables, -6.0);
+
+    // specific function patterns are found although the function invocation
+    // wildcard matches any call as well
+    phylanx::execution_tree::pattern_list specific_first = {
+        phylanx::execution_tree::primitives::block_operation::match_data,
+        phylanx::execution_tree::primitives::define_::match_data,
+        phylanx::execution_tree::primitives::dot_operation::match_data,
+        phylanx::execution_tree::primitives::add_operation::match_data,
+        phylanx::execution_tree::primitives::mul_operation::match_data,
+        phylanx::execution_tree::primitives::define_::invocation_match_data
+    };
+
+    test_generate_tree("block(define(f, x, x * 2.0), f(dot(A, B)))",
+        specific_first, variables, 12.0);
+    test_generate_tree("block(define(dot, x, y, x + y), dot(A, B))",
+        specific_first, variables, 6.0);
+
+    // a wildcard listed before a specific pattern takes precedence
+    phylanx::execution_tree::pattern_list wildcard_first = {
+        phylanx::execution_tree::primitives::block_operation::match_data,
+        phylanx::execution_tree::primitives::define_::match_data,
+        phylanx::execution_tree::primitives::add_operation::match_data,
+        phylanx::execution_tree::primitives::define_::invocation_match_data,
+        phylanx::execution_tree::primitives::dot_operation::match_data
+    };
+
+    test_generate_tree("block(define(dot, x, y, x + y), dot(A, B))",
+        wildcard_first, variables, 5.0);
+
+    // of two patterns for the same function the first one listed is used
+    std::vector<phylanx::execution_tree::match_pattern_type> replace_dot = {
+        hpx::util::make_tuple("replace_dot", "dot(inverse(_1), _2)",
+            &create<phylanx::execution_tree::primitives::add_operation>)
+    };
+
+    phylanx::execution_tree::pattern_list replacement_first = {
+        replace_dot,
+        phylanx::execution_tree::primitives::dot_operation::match_data,
+        phylanx::execution_tree::primitives::inverse_operation::match_data
+    };
+    test_generate_tree(
+        "dot(inverse(A), B)", replacement_first, variables, 5.0);
+
+    phylanx::execution_tree::pattern_list replacement_last = {
+        phylanx::execution_tree::primitives::dot_operation::match_data,
+        replace_dot,
+        phylanx::execution_tree::primitives::inverse_operation::match_data
+    };
+    test_generate_tree(
+        "dot(inverse(A), B)", replacement_last, variables, 1.5);
+
+    // solve replaces dot(inverse(_1), _2), so it has to precede dot
+    std::size_t solve_index = 0, dot_index = 0, index = 0;
+    for (auto const& patterns :
+        phylanx::execution_tree::get_all_known_patterns())
+    {
+        for (auto const& pattern : patterns)
+        {
+            if (hpx::util::get<1>(pattern) == "dot(inverse(_1), _2)")
+            {
+                solve_index = index;
+            }
+            else if (hpx::util::get<1>(pattern) == "dot(_1, _2)")
+            {
+                dot_index = index;
+            }
+            ++index;
+        }
+    }
+    HPX_TEST_LT(solve_index, dot_index);
+}
+
 int main(int argc, char* argv[])
 {
     test_add_primitive();
@@ -366,6 +533,10 @@ int main(int argc, char* argv[])
     test_complex_expression();
     test_multi_patterns();
     test_if_conditional();
+    test_deeply_nested_expression();
+    test_constant_folding();
+    test_register_patterns();
+    test_pattern_index();
 
     return hpx::util::report_errors();
 }
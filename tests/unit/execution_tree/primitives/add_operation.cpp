@@ -11,6 +11,8 @@
 
 #include <Eigen/Dense>
 
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -172,6 +174,155 @@ void test_add_operation_2d_lit()
         phylanx::execution_tree::extract_numeric_value(f.get()));
 }
 
+void test_add_operation_3d()
+{
+    Eigen::VectorXd v1 = Eigen::VectorXd::Random(24);
+    Eigen::VectorXd v2 = Eigen::VectorXd::Random(24);
+
+    phylanx::ir::node_data<double> lhs =
+        phylanx::ir::node_data<double>(v1).reshape({2, 3, 4});
+
+    // the right hand side is a permuted (non-contiguous) array
+    phylanx::ir::node_data<double> rhs =
+        phylanx::ir::node_data<double>(v2).reshape({3, 4, 2}).permute(
+            {2, 0, 1});
+
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                lhs, rhs
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        add.eval();
+
+    phylanx::ir::node_data<double> result =
+        phylanx::execution_tree::extract_numeric_value(f.get());
+
+    HPX_TEST_EQ(result.num_dimensions(), std::size_t(3));
+    HPX_TEST(result.shape() ==
+        phylanx::ir::node_data<double>::shape_type({2, 3, 4}));
+
+    for (std::ptrdiff_t i = 0; i != 2; ++i)
+    {
+        for (std::ptrdiff_t j = 0; j != 3; ++j)
+        {
+            for (std::ptrdiff_t k = 0; k != 4; ++k)
+            {
+                HPX_TEST_EQ(result.at({i, j, k}),
+                    lhs.at({i, j, k}) + rhs.at({i, j, k}));
+            }
+        }
+    }
+}
+
+void test_add_operation_2d_large()
+{
+    // large arrays are added in chunks on separate threads
+    Eigen::MatrixXd m1 = Eigen::MatrixXd::Random(1001, 101);
+    Eigen::MatrixXd m2 = Eigen::MatrixXd::Random(1001, 101);
+
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(m1),
+                phylanx::ir::node_data<double>(m2)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        add.eval();
+
+    Eigen::MatrixXd expected = m1.array() + m2.array();
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_add_operation_2d_many(std::size_t count)
+{
+    // integral values are summed exactly in any order
+    std::vector<phylanx::execution_tree::primitive_argument_type> operands;
+    Eigen::MatrixXd expected;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        Eigen::MatrixXd m = (100.0 * Eigen::MatrixXd::Random(101, 101)).array()
+            .round();
+        if (i == 0)
+        {
+            expected = m;
+        }
+        else
+        {
+            expected.array() += m.array();
+        }
+        operands.push_back(phylanx::ir::node_data<double>(std::move(m)));
+    }
+
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(), std::move(operands));
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        add.eval();
+
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_add_operation_float()
+{
+    // arrays of float are added without converting them to double
+    Eigen::MatrixXf m1 = Eigen::MatrixXf::Random(42, 5);
+    Eigen::MatrixXf m2 = Eigen::MatrixXf::Random(42, 5);
+
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<float>(m1),
+                phylanx::ir::node_data<float>(m2),
+                phylanx::ir::node_data<double>(1.0)
+            });
+
+    phylanx::execution_tree::primitive_result_type result = add.eval().get();
+
+    auto const* value =
+        phylanx::util::get_if<phylanx::ir::node_data<float>>(&result);
+    HPX_TEST(value != nullptr);
+
+    Eigen::MatrixXf expected = m1.array() + m2.array() + 1.0f;
+    HPX_TEST_EQ(phylanx::ir::node_data<float>(std::move(expected)), *value);
+}
+
+void test_add_operation_promoted()
+{
+    // int64 and float arrays are promoted to double
+    Eigen::Matrix<std::int64_t, Eigen::Dynamic, Eigen::Dynamic> m1(2, 3);
+    m1 << 1, 2, 3, 4, 5, 6;
+    Eigen::MatrixXf m2 = Eigen::MatrixXf::Random(2, 3);
+
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<std::int64_t>(m1),
+                phylanx::ir::node_data<float>(m2)
+            });
+
+    phylanx::execution_tree::primitive_result_type result = add.eval().get();
+
+    auto const* value =
+        phylanx::util::get_if<phylanx::ir::node_data<double>>(&result);
+    HPX_TEST(value != nullptr);
+
+    Eigen::MatrixXd expected =
+        m1.cast<double>().array() + m2.cast<double>().array();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)), *value);
+}
+
 int main(int argc, char* argv[])
 {
     test_add_operation_0d();
@@ -183,6 +334,15 @@ int main(int argc, char* argv[])
     test_add_operation_2d();
     test_add_operation_2d_lit();
 
+    test_add_operation_3d();
+
+    test_add_operation_2d_large();
+    test_add_operation_2d_many(3);
+    test_add_operation_2d_many(64);
+
+    test_add_operation_float();
+    test_add_operation_promoted();
+
     return hpx::util::report_errors();
 }
 
@@ -0,0 +1,96 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_cholesky_factorization_0d()
+{
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(4.0));
+
+    phylanx::execution_tree::primitive cholesky = hpx::new_<
+        phylanx::execution_tree::primitives::cholesky_factorization>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        cholesky.eval();
+
+    HPX_TEST_EQ(
+        2.0, phylanx::execution_tree::extract_numeric_value(f.get())[0]);
+}
+
+void test_cholesky_factorization_2d()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd m = a * a.transpose() +
+        42.0 * Eigen::MatrixXd::Identity(42, 42);
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    phylanx::execution_tree::primitive cholesky = hpx::new_<
+        phylanx::execution_tree::primitives::cholesky_factorization>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        cholesky.eval();
+
+    Eigen::MatrixXd expected = m.llt().matrixL();
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_cholesky_factorization_indefinite()
+{
+    Eigen::MatrixXd m = -Eigen::MatrixXd::Identity(42, 42);
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    phylanx::execution_tree::primitive cholesky = hpx::new_<
+        phylanx::execution_tree::primitives::cholesky_factorization>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs)
+            });
+
+    bool caught = false;
+    try
+    {
+        cholesky.eval().get();
+    }
+    catch (hpx::exception const&)
+    {
+        caught = true;
+    }
+    HPX_TEST(caught);
+}
+
+int main(int argc, char* argv[])
+{
+    test_cholesky_factorization_0d();
+    test_cholesky_factorization_2d();
+    test_cholesky_factorization_indefinite();
+
+    return hpx::util::report_errors();
+}
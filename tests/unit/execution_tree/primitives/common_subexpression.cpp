@@ -0,0 +1,99 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_common_subexpression()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::primitive x =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(a));
+
+    phylanx::execution_tree::primitive dot =
+        hpx::new_<phylanx::execution_tree::primitives::dot_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                x, x
+            });
+
+    phylanx::execution_tree::primitive shared =
+        hpx::new_<phylanx::execution_tree::primitives::common_subexpression>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(dot)
+            });
+
+    Eigen::MatrixXd expected = a * a;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        phylanx::execution_tree::extract_numeric_value(shared.eval().get()));
+
+    // the memoized value is used as long as no variable changes
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        phylanx::execution_tree::extract_numeric_value(shared.eval().get()));
+
+    // modifying a variable invalidates the memoized value
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(42, 42);
+    x.store(hpx::launch::sync, phylanx::ir::node_data<double>(b));
+
+    expected = b * b;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(shared.eval().get()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> evaluate(char const* expr,
+    phylanx::execution_tree::variables::map_type const& vars)
+{
+    auto p = phylanx::execution_tree::generate_tree(
+        expr, phylanx::execution_tree::variables(vars));
+    return phylanx::execution_tree::numeric_operand(p).get();
+}
+
+void test_generate_common_subexpressions()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"A", phylanx::ir::node_data<double>(a)},
+        {"B", phylanx::ir::node_data<double>(b)},
+        {"C", phylanx::ir::node_data<double>(0.0)}
+    };
+
+    // dot(A, B) is evaluated once
+    Eigen::MatrixXd expected = a * b + (a * b).transpose();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("dot(A, B) + transpose(dot(A, B))", vars));
+
+    // dot(A, B) is evaluated again after A was modified
+    expected = b * b - a * b;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("block(store(C, dot(A, B)), store(A, B), dot(A, B) - C)",
+            vars));
+
+    // expressions referring to impure operations are never shared, not even
+    // if their outermost operation is pure
+    phylanx::ir::node_data<double> diff =
+        evaluate("exp(random(1000)) - exp(random(1000))", vars);
+    HPX_TEST(!diff.matrix().isZero(0.0));
+}
+
+int main(int argc, char* argv[])
+{
+    test_common_subexpression();
+    test_generate_common_subexpressions();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,99 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> solve(
+    std::vector<phylanx::execution_tree::primitive_argument_type>&& operands)
+{
+    phylanx::execution_tree::primitive p =
+        hpx::new_<phylanx::execution_tree::primitives::conjugate_gradient>(
+            hpx::find_here(), std::move(operands));
+
+    return phylanx::execution_tree::extract_numeric_value(p.eval().get());
+}
+
+void test_conjugate_gradient_dense()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd m = a * a.transpose() +
+        42.0 * Eigen::MatrixXd::Identity(42, 42);
+    Eigen::VectorXd b = Eigen::VectorXd::Random(42);
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    phylanx::ir::node_data<double> x = solve({std::move(lhs),
+        phylanx::ir::node_data<double>(b),
+        phylanx::ir::node_data<double>(1e-12)});
+
+    Eigen::VectorXd r = m * x.matrix() - b;
+    HPX_TEST(r.norm() <= 1e-10 * b.norm());
+}
+
+void test_conjugate_gradient_sparse()
+{
+    // a large sparse system, its products are computed concurrently
+    std::ptrdiff_t const size = 100000;
+
+    std::vector<Eigen::Triplet<double>> elements;
+    for (std::ptrdiff_t i = 0; i != size; ++i)
+    {
+        elements.emplace_back(i, i, 4.0);
+        if (i != 0)
+        {
+            elements.emplace_back(i, i - 1, -1.0);
+            elements.emplace_back(i - 1, i, -1.0);
+        }
+    }
+
+    Eigen::SparseMatrix<double> m(size, size);
+    m.setFromTriplets(elements.begin(), elements.end());
+    Eigen::VectorXd b = Eigen::VectorXd::Random(size);
+
+    phylanx::ir::node_data<double> x = solve({
+        phylanx::ir::node_data<double>(m), phylanx::ir::node_data<double>(b),
+        phylanx::ir::node_data<double>(1e-12)});
+
+    Eigen::VectorXd r = m * x.matrix() - b;
+    HPX_TEST(r.norm() <= 1e-10 * b.norm());
+}
+
+void test_conjugate_gradient_warm_start()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd m = a * a.transpose() +
+        42.0 * Eigen::MatrixXd::Identity(42, 42);
+    Eigen::VectorXd b = Eigen::VectorXd::Random(42);
+    Eigen::VectorXd x0 = m.partialPivLu().solve(b);
+
+    // no iterations are performed, the initial approximation is returned
+    phylanx::ir::node_data<double> x = solve({
+        phylanx::ir::node_data<double>(m), phylanx::ir::node_data<double>(b),
+        phylanx::ir::node_data<double>(1e-12),
+        phylanx::ir::node_data<double>(0.0),
+        phylanx::ir::node_data<double>(x0)});
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(x0), x);
+}
+
+int main(int argc, char* argv[])
+{
+    test_conjugate_gradient_dense();
+    test_conjugate_gradient_sparse();
+    test_conjugate_gradient_warm_start();
+
+    return hpx::util::report_errors();
+}
@@ -10,7 +10,9 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
+#include <cstddef>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -130,12 +132,79 @@ void test_dot_operation_2d2()
         phylanx::execution_tree::extract_numeric_value(f.get())[0]);
 }
 
+void test_dot_operation_2d_sparse()
+{
+    Eigen::SparseMatrix<double> m(64, 32);
+    for (int i = 0; i != 32; ++i)
+    {
+        m.insert(2 * i, i) = i + 1.0;
+    }
+    m.makeCompressed();
+
+    Eigen::VectorXd v = Eigen::VectorXd::Random(32);
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    phylanx::execution_tree::primitive rhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(v));
+
+    phylanx::execution_tree::primitive dot =
+        hpx::new_<phylanx::execution_tree::primitives::dot_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        dot.eval();
+
+    Eigen::VectorXd expected = m * v;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_dot_operation_2d_large(
+    std::ptrdiff_t rows, std::ptrdiff_t inner, std::ptrdiff_t cols)
+{
+    // large products are computed in tiles on separate threads, integral
+    // values are multiplied and summed exactly in any order
+    Eigen::MatrixXd m1 = (10.0 * Eigen::MatrixXd::Random(rows, inner))
+        .array().round();
+    Eigen::MatrixXd m2 = (10.0 * Eigen::MatrixXd::Random(inner, cols))
+        .array().round();
+
+    phylanx::execution_tree::primitive dot =
+        hpx::new_<phylanx::execution_tree::primitives::dot_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(m1),
+                phylanx::ir::node_data<double>(m2)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        dot.eval();
+
+    Eigen::MatrixXd expected = m1 * m2;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
 int main(int argc, char* argv[])
 {
     test_dot_operation_0d();
     test_dot_operation_1d();
     test_dot_operation_2d1();
     test_dot_operation_2d2();
+    test_dot_operation_2d_sparse();
+    test_dot_operation_2d_large(2001, 600, 1);
+    test_dot_operation_2d_large(601, 300, 513);
+
+    // smaller than the default tile size, but split into tiles of 100 rows
+    // and columns (see CMakeLists.txt)
+    test_dot_operation_2d_large(250, 130, 170);
 
     return hpx::util::report_errors();
 }
@@ -0,0 +1,159 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <unsupported/Eigen/MatrixFunctions>
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using opcode = phylanx::execution_tree::primitives::fused_instruction::opcode;
+
+///////////////////////////////////////////////////////////////////////////////
+// 1.0 / (1.0 + exp(-x))
+std::vector<phylanx::execution_tree::primitives::fused_instruction>
+sigmoid_program()
+{
+    using phylanx::execution_tree::primitives::fused_instruction;
+
+    std::vector<fused_instruction> program;
+    program.emplace_back(opcode::load, std::vector<std::size_t>{0});
+    program.emplace_back(opcode::load, std::vector<std::size_t>{1});
+    program.emplace_back(opcode::load, std::vector<std::size_t>{2});
+    program.emplace_back(opcode::negate, std::vector<std::size_t>{2});
+    program.emplace_back(opcode::exp, std::vector<std::size_t>{3});
+    program.emplace_back(opcode::add, std::vector<std::size_t>{1, 4});
+    program.emplace_back(opcode::div, std::vector<std::size_t>{0, 5});
+    return program;
+}
+
+void test_fused_operation_nd()
+{
+    std::vector<double> v(1000);
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        v[i] = 0.01 * double(i) - 5.0;
+    }
+
+    phylanx::ir::node_data<double> x =
+        phylanx::ir::node_data<double>(v).reshape({10, 20, 5});
+
+    phylanx::execution_tree::primitive fused =
+        hpx::new_<phylanx::execution_tree::primitives::fused_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(1.0),
+                phylanx::ir::node_data<double>(1.0), x
+            },
+            sigmoid_program());
+
+    phylanx::ir::node_data<double> result =
+        phylanx::execution_tree::extract_numeric_value(fused.eval().get());
+
+    HPX_TEST_EQ(result.num_dimensions(), std::size_t(3));
+    HPX_TEST(result.shape() == x.shape());
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        HPX_TEST_EQ(result[i], 1.0 / (1.0 + std::exp(-v[i])));
+    }
+}
+
+void test_fused_operation_0d()
+{
+    phylanx::execution_tree::primitive x =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(2.0));
+
+    phylanx::execution_tree::primitive fused =
+        hpx::new_<phylanx::execution_tree::primitives::fused_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(1.0),
+                phylanx::ir::node_data<double>(1.0), std::move(x)
+            },
+            sigmoid_program());
+
+    HPX_TEST_EQ(1.0 / (1.0 + std::exp(-2.0)),
+        phylanx::execution_tree::extract_numeric_value(
+            fused.eval().get())[0]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> evaluate(char const* expr,
+    phylanx::execution_tree::variables::map_type const& vars)
+{
+    auto p = phylanx::execution_tree::generate_tree(
+        expr, phylanx::execution_tree::variables(vars));
+    return phylanx::execution_tree::numeric_operand(p).get();
+}
+
+void test_generate_fused_tree()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"A", phylanx::ir::node_data<double>(a)},
+        {"B", phylanx::ir::node_data<double>(b)},
+        {"x", phylanx::ir::node_data<double>(0.5)}
+    };
+
+    // element-wise operations are fused
+    HPX_TEST_EQ(1.0 / (1.0 + std::exp(-0.5)),
+        evaluate("1.0 / (1.0 + exp(-x))", vars)[0]);
+
+    Eigen::MatrixXd expected = -(a + b);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("-(A + B)", vars));
+
+    expected = (a.array() / (1.0 - b.array())).matrix();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("A / (1.0 - B)", vars));
+
+    // matrix products and matrix exponentials retain their meaning
+    expected = -(a * b);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("-(A * B)", vars));
+
+    expected = (-a).exp();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("exp(-A)", vars));
+}
+
+void test_generate_fused_tree_large()
+{
+    // large enough to be processed concurrently in chunks, the last of
+    // which is incomplete
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(301, 299);
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(301, 299);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"A", phylanx::ir::node_data<double>(a)},
+        {"B", phylanx::ir::node_data<double>(b)}
+    };
+
+    Eigen::MatrixXd expected =
+        (a.array() / (1.0 - b.array()) + a.array()).matrix();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("A / (1.0 - B) + A", vars));
+}
+
+int main(int argc, char* argv[])
+{
+    test_fused_operation_nd();
+    test_fused_operation_0d();
+
+    test_generate_fused_tree();
+    test_generate_fused_tree_large();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,143 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_last_use()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::primitive x =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(a));
+
+    phylanx::execution_tree::primitive last_use =
+        hpx::new_<phylanx::execution_tree::primitives::last_use>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                x
+            });
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(a),
+        phylanx::execution_tree::extract_numeric_value(
+            last_use.eval().get()));
+
+    // the value was handed over, the variable is empty now
+    HPX_TEST(!phylanx::execution_tree::valid(x.eval().get()));
+}
+
+void test_last_use_failed_store()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(3, 4);
+
+    phylanx::execution_tree::primitive x =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(a));
+
+    phylanx::execution_tree::primitive last_use =
+        hpx::new_<phylanx::execution_tree::primitives::last_use>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                x
+            });
+
+    // adding arrays of different shapes throws
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(last_use), phylanx::ir::node_data<double>(b)
+            });
+
+    phylanx::execution_tree::primitive store =
+        hpx::new_<phylanx::execution_tree::primitives::store_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                x, std::move(add)
+            });
+
+    bool caught_exception = false;
+    try
+    {
+        store.eval().get();
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    // the value was handed over (and may have been modified in place), the
+    // variable is left empty
+    HPX_TEST(!phylanx::execution_tree::valid(x.eval().get()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> evaluate(char const* expr,
+    phylanx::execution_tree::variables::map_type const& vars)
+{
+    auto p = phylanx::execution_tree::generate_tree(
+        expr, phylanx::execution_tree::variables(vars));
+    return phylanx::execution_tree::numeric_operand(p).get();
+}
+
+void test_generate_last_uses()
+{
+    Eigen::MatrixXd w = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd g = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"w", phylanx::ir::node_data<double>(w)},
+        {"g", phylanx::ir::node_data<double>(g)}
+    };
+
+    // the old value of w is used for the last time
+    Eigen::MatrixXd expected = w - 0.1 * g;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("block(store(w, w - 0.1 * g), w)", vars));
+
+    expected = w - 2.5 * g;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate(R"(
+            block(
+                store(i, 0),
+                while(
+                    i < 5,
+                    block(
+                        store(w, w - 0.5 * g),
+                        store(i, i + 1)
+                    )
+                ),
+                w
+            )
+        )", vars));
+
+    // the old value of w is still needed by other uses
+    expected = w + w - g;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("block(store(w, w + w - g), w)", vars));
+
+    expected = (w - g) + w;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("block(store(v, w), store(w, w - g), w + v)", vars));
+}
+
+int main(int argc, char* argv[])
+{
+    test_last_use();
+    test_last_use_failed_store();
+    test_generate_last_uses();
+
+    return hpx::util::report_errors();
+}
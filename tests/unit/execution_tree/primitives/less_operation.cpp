@@ -11,6 +11,7 @@
 
 #include <Eigen/Dense>
 
+#include <cstdint>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -211,6 +212,34 @@ void test_less_operation_2d_lit()
         phylanx::execution_tree::extract_boolean_value(f.get()) != 0);
 }
 
+void test_less_operation_mask()
+{
+    // comparing arrays yields a mask, float and int64 are compared as double
+    Eigen::MatrixXf m1 = 10.0f * Eigen::MatrixXf::Random(42, 5);
+    Eigen::Matrix<std::int64_t, Eigen::Dynamic, Eigen::Dynamic> m2 =
+        (10.0f * Eigen::MatrixXf::Random(42, 5)).cast<std::int64_t>();
+
+    phylanx::execution_tree::primitive less =
+        hpx::new_<phylanx::execution_tree::primitives::less>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<float>(m1),
+                phylanx::ir::node_data<std::int64_t>(m2)
+            });
+
+    phylanx::execution_tree::primitive_result_type result = less.eval().get();
+
+    auto const* mask =
+        phylanx::util::get_if<phylanx::ir::node_data<std::uint8_t>>(&result);
+    HPX_TEST(mask != nullptr);
+
+    Eigen::Matrix<std::uint8_t, Eigen::Dynamic, Eigen::Dynamic> expected =
+        (m1.cast<double>().array() < m2.cast<double>().array())
+            .cast<std::uint8_t>();
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<std::uint8_t>(std::move(expected)), *mask);
+}
+
 int main(int argc, char* argv[])
 {
     test_less_operation_0d_false();
@@ -224,6 +253,8 @@ int main(int argc, char* argv[])
     test_less_operation_2d();
     test_less_operation_2d_lit();
 
+    test_less_operation_mask();
+
     return hpx::util::report_errors();
 }
 
@@ -0,0 +1,126 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_loop_invariant()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::primitive x =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(a));
+
+    phylanx::execution_tree::primitive transpose =
+        hpx::new_<phylanx::execution_tree::primitives::transpose_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{x});
+
+    phylanx::execution_tree::primitive invariant =
+        hpx::new_<phylanx::execution_tree::primitives::loop_invariant>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(transpose)
+            });
+
+    Eigen::MatrixXd expected = a.transpose();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        phylanx::execution_tree::extract_numeric_value(
+            invariant.eval().get()));
+
+    // the value is evaluated once
+    x.store(hpx::launch::sync, phylanx::ir::node_data<double>(b));
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        phylanx::execution_tree::extract_numeric_value(
+            invariant.eval().get()));
+
+    // until the invariant is reset
+    invariant.store(hpx::launch::sync,
+        phylanx::execution_tree::primitive_result_type{});
+
+    expected = b.transpose();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(
+            invariant.eval().get()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> evaluate(char const* expr,
+    phylanx::execution_tree::variables::map_type const& vars)
+{
+    auto p = phylanx::execution_tree::generate_tree(
+        expr, phylanx::execution_tree::variables(vars));
+    return phylanx::execution_tree::numeric_operand(p).get();
+}
+
+void test_generate_loop_invariants()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"x", phylanx::ir::node_data<double>(a)}
+    };
+
+    // transpose(x) is evaluated once
+    Eigen::MatrixXd expected = 3.0 * a.transpose();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate(R"(
+            block(
+                store(s, constant(0, x)),
+                store(i, 0),
+                while(
+                    i < 3,
+                    block(
+                        store(s, s + transpose(x)),
+                        store(i, i + 1)
+                    )
+                ),
+                s
+            )
+        )", vars));
+
+    // transpose(x) is evaluated once for each execution of the inner loop
+    expected = 6.0 * a.transpose();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate(R"(
+            block(
+                store(s, constant(0, x)),
+                store(i, 0),
+                while(
+                    i < 2,
+                    block(
+                        store(j, 0),
+                        while(
+                            j < 2,
+                            block(
+                                store(s, s + transpose(x)),
+                                store(j, j + 1)
+                            )
+                        ),
+                        store(x, x + x),
+                        store(i, i + 1)
+                    )
+                ),
+                s
+            )
+        )", vars));
+}
+
+int main(int argc, char* argv[])
+{
+    test_loop_invariant();
+    test_generate_loop_invariants();
+
+    return hpx::util::report_errors();
+}
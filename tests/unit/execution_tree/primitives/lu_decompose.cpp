@@ -0,0 +1,83 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+Eigen::MatrixXd lu_decompose(
+    phylanx::execution_tree::primitive const& matrix, char const* part)
+{
+    std::vector<phylanx::execution_tree::primitive_argument_type> operands{
+        matrix};
+    if (part != nullptr)
+    {
+        operands.push_back(std::string(part));
+    }
+
+    phylanx::execution_tree::primitive lu =
+        hpx::new_<phylanx::execution_tree::primitives::lu_decompose>(
+            hpx::find_here(), std::move(operands));
+
+    return phylanx::execution_tree::extract_numeric_value(lu.eval().get())
+        .matrix();
+}
+
+void test_lu_decompose(int rows, int cols)
+{
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(rows, cols);
+
+    phylanx::execution_tree::primitive matrix =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    Eigen::MatrixXd l = lu_decompose(matrix, "L");
+    Eigen::MatrixXd u = lu_decompose(matrix, "U");
+    Eigen::MatrixXd p = lu_decompose(matrix, "P");
+
+    HPX_TEST_EQ(l.rows(), rows);
+    HPX_TEST_EQ(u.cols(), cols);
+    HPX_TEST_EQ(p.rows(), rows);
+    HPX_TEST((p * m - l * u).norm() < 1e-10 * m.norm());
+
+    // the packed form combines both factors
+    Eigen::MatrixXd lu = lu_decompose(matrix, nullptr);
+    Eigen::MatrixXd expected = u;
+    expected.leftCols(u.rows()).triangularView<Eigen::StrictlyLower>() =
+        l.topRows(u.rows());
+    HPX_TEST(lu.topRows(u.rows()) == expected);
+}
+
+void test_lu_decompose_singular()
+{
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(200, 200);
+    m.col(150).setZero();
+
+    phylanx::execution_tree::primitive matrix =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    Eigen::MatrixXd u = lu_decompose(matrix, "U");
+    HPX_TEST_EQ(u(150, 150), 0.0);
+    HPX_TEST((lu_decompose(matrix, "P") * m - lu_decompose(matrix, "L") * u)
+                 .norm() < 1e-10 * m.norm());
+}
+
+int main(int argc, char* argv[])
+{
+    test_lu_decompose(42, 42);
+    test_lu_decompose(300, 200);
+    test_lu_decompose(200, 300);
+    test_lu_decompose_singular();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,79 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> lu(
+    phylanx::execution_tree::primitive const& matrix, char const* part)
+{
+    std::vector<phylanx::execution_tree::primitive_argument_type> operands{
+        matrix};
+    if (part != nullptr)
+    {
+        operands.push_back(std::string(part));
+    }
+
+    phylanx::execution_tree::primitive lu =
+        hpx::new_<phylanx::execution_tree::primitives::lu_factorization>(
+            hpx::find_here(), std::move(operands));
+
+    return phylanx::execution_tree::extract_numeric_value(lu.eval().get());
+}
+
+void test_lu_factorization_0d()
+{
+    phylanx::execution_tree::primitive m =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(5.0));
+
+    HPX_TEST_EQ(5.0, lu(m, nullptr)[0]);
+    HPX_TEST_EQ(1.0, lu(m, "L")[0]);
+    HPX_TEST_EQ(5.0, lu(m, "U")[0]);
+    HPX_TEST_EQ(1.0, lu(m, "P")[0]);
+}
+
+void test_lu_factorization_2d()
+{
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(42, 42);
+    Eigen::PartialPivLU<Eigen::MatrixXd> decomposition(m);
+
+    phylanx::execution_tree::primitive matrix =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    Eigen::MatrixXd expected = decomposition.matrixLU();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        lu(matrix, nullptr));
+
+    expected = decomposition.matrixLU().triangularView<Eigen::UnitLower>();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        lu(matrix, "L"));
+
+    expected = decomposition.matrixLU().triangularView<Eigen::Upper>();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        lu(matrix, "U"));
+
+    expected = decomposition.permutationP() *
+        Eigen::MatrixXd::Identity(42, 42);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        lu(matrix, "P"));
+}
+
+int main(int argc, char* argv[])
+{
+    test_lu_factorization_0d();
+    test_lu_factorization_2d();
+
+    return hpx::util::report_errors();
+}
@@ -332,6 +332,83 @@ void test_mul_operation_2d_lit()
         phylanx::execution_tree::extract_numeric_value(f.get()));
 }
 
+void test_mul_operation_chain()
+{
+    Eigen::MatrixXd m1 = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd m2 = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd v = Eigen::MatrixXd::Random(42, 1);
+
+    phylanx::execution_tree::primitive mul =
+        hpx::new_<phylanx::execution_tree::primitives::mul_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(m1),
+                phylanx::ir::node_data<double>(m2),
+                phylanx::ir::node_data<double>(v)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        mul.eval();
+
+    // the product is computed as m1 * (m2 * v)
+    Eigen::MatrixXd expected = m1 * (m2 * v);
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_mul_operation_chain_0d()
+{
+    Eigen::MatrixXd m1 = Eigen::MatrixXd::Random(30, 5);
+    Eigen::MatrixXd m2 = Eigen::MatrixXd::Random(5, 40);
+    Eigen::MatrixXd m3 = Eigen::MatrixXd::Random(40, 10);
+
+    phylanx::execution_tree::primitive mul =
+        hpx::new_<phylanx::execution_tree::primitives::mul_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(m1),
+                phylanx::ir::node_data<double>(m2),
+                phylanx::ir::node_data<double>(2.0),
+                phylanx::ir::node_data<double>(m3)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        mul.eval();
+
+    // the product is computed as m1 * (m2 * m3), the scalar is applied last
+    Eigen::MatrixXd expected = m1 * (m2 * m3);
+    expected *= 2.0;
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_mul_operation_2d_mismatch()
+{
+    Eigen::MatrixXd m1 = Eigen::MatrixXd::Random(42, 41);
+    Eigen::MatrixXd m2 = Eigen::MatrixXd::Random(42, 42);
+
+    phylanx::execution_tree::primitive mul =
+        hpx::new_<phylanx::execution_tree::primitives::mul_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(m1),
+                phylanx::ir::node_data<double>(m2)
+            });
+
+    bool caught_exception = false;
+    try
+    {
+        mul.eval().get();
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
 int main(int argc, char* argv[])
 {
     test_mul_operation_0d();
@@ -352,6 +429,10 @@ int main(int argc, char* argv[])
     test_mul_operation_2d();
     test_mul_operation_2d_lit();
 
+    test_mul_operation_chain();
+    test_mul_operation_chain_0d();
+    test_mul_operation_2d_mismatch();
+
     return hpx::util::report_errors();
 }
 
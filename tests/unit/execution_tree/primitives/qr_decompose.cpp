@@ -0,0 +1,69 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+Eigen::MatrixXd qr_decompose(
+    phylanx::execution_tree::primitive const& matrix, char const* part)
+{
+    std::vector<phylanx::execution_tree::primitive_argument_type> operands{
+        matrix};
+    if (part != nullptr)
+    {
+        operands.push_back(std::string(part));
+    }
+
+    phylanx::execution_tree::primitive qr =
+        hpx::new_<phylanx::execution_tree::primitives::qr_decompose>(
+            hpx::find_here(), std::move(operands));
+
+    return phylanx::execution_tree::extract_numeric_value(qr.eval().get())
+        .matrix();
+}
+
+void test_qr_decompose(int rows, int cols)
+{
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(rows, cols);
+
+    phylanx::execution_tree::primitive matrix =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    int steps = (std::min)(rows, cols);
+
+    Eigen::MatrixXd q = qr_decompose(matrix, "Q");
+    Eigen::MatrixXd r = qr_decompose(matrix, "R");
+
+    HPX_TEST_EQ(q.rows(), rows);
+    HPX_TEST_EQ(q.cols(), steps);
+    HPX_TEST_EQ(r.rows(), steps);
+    HPX_TEST_EQ(r.cols(), cols);
+
+    HPX_TEST((q * r - m).norm() < 1e-10 * m.norm());
+    HPX_TEST((q.transpose() * q - Eigen::MatrixXd::Identity(steps, steps))
+                 .norm() < 1e-10);
+    HPX_TEST(r.isUpperTriangular());
+    HPX_TEST(r == qr_decompose(matrix, nullptr));
+}
+
+int main(int argc, char* argv[])
+{
+    test_qr_decompose(42, 42);
+    test_qr_decompose(300, 300);
+    test_qr_decompose(300, 200);
+    test_qr_decompose(200, 300);
+
+    return hpx::util::report_errors();
+}
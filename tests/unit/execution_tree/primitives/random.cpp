@@ -11,6 +11,8 @@
 
 #include <Eigen/Dense>
 
+#include <cmath>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -84,11 +86,62 @@ void test_random_2d()
     HPX_TEST_EQ(result.dimension(1), 105);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> random_matrix(std::string const& distribution,
+    double seed, double stream)
+{
+    phylanx::execution_tree::primitive dim =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(),
+            phylanx::ir::node_data<double>(Eigen::MatrixXd::Zero(301, 307)));
+
+    phylanx::execution_tree::primitive random =
+        hpx::new_<phylanx::execution_tree::primitives::random>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(dim), distribution,
+                phylanx::ir::node_data<double>(seed),
+                phylanx::ir::node_data<double>(stream)
+            });
+
+    return phylanx::execution_tree::extract_numeric_value(
+        random.eval().get());
+}
+
+void test_random_seed()
+{
+    // the same seed and stream reproduce the same array
+    auto first = random_matrix("uniform", 42.0, 0.0);
+    HPX_TEST_EQ(first, random_matrix("uniform", 42.0, 0.0));
+    HPX_TEST(first != random_matrix("uniform", 42.0, 1.0));
+    HPX_TEST(first != random_matrix("uniform", 43.0, 0.0));
+
+    Eigen::Map<Eigen::ArrayXd const> values(first.data(), first.size());
+    HPX_TEST(values.minCoeff() >= -1.0 && values.maxCoeff() < 1.0);
+}
+
+void test_random_distributions()
+{
+    auto normal = random_matrix("normal", 1.0, 0.0);
+    Eigen::Map<Eigen::ArrayXd const> values(normal.data(), normal.size());
+    double mean = values.mean();
+    double variance = (values - mean).square().mean();
+    HPX_TEST(std::abs(mean) < 0.05);
+    HPX_TEST(std::abs(variance - 1.0) < 0.05);
+
+    auto bernoulli = random_matrix("bernoulli", 1.0, 0.0);
+    Eigen::Map<Eigen::ArrayXd const> bits(bernoulli.data(), bernoulli.size());
+    HPX_TEST(((bits == 0.0) || (bits == 1.0)).all());
+    HPX_TEST(std::abs(bits.mean() - 0.5) < 0.05);
+}
+
 int main(int argc, char* argv[])
 {
     test_random_0d();
     test_random_1d();
     test_random_2d();
+    test_random_seed();
+    test_random_distributions();
 
     return hpx::util::report_errors();
 }
@@ -0,0 +1,217 @@
+//   Copyright (c) 2026 agent
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_solve_operation_0d()
+{
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(4.0));
+
+    Eigen::VectorXd v = Eigen::VectorXd::Random(42);
+
+    phylanx::execution_tree::primitive solve =
+        hpx::new_<phylanx::execution_tree::primitives::solve_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), phylanx::ir::node_data<double>(v)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        solve.eval();
+
+    Eigen::VectorXd expected = v / 4.0;
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_solve_operation_2d_lu()
+{
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(42, 42);
+    Eigen::VectorXd v = Eigen::VectorXd::Random(42);
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    phylanx::execution_tree::primitive rhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(v));
+
+    phylanx::execution_tree::primitive solve =
+        hpx::new_<phylanx::execution_tree::primitives::solve_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)
+            });
+
+    Eigen::VectorXd expected = m.partialPivLu().solve(v);
+
+    // the second evaluation reuses the decomposition of the matrix
+    for (int i = 0; i != 2; ++i)
+    {
+        hpx::future<phylanx::execution_tree::primitive_result_type> f =
+            solve.eval();
+
+        HPX_TEST_EQ(
+            phylanx::ir::node_data<double>(expected),
+            phylanx::execution_tree::extract_numeric_value(f.get()));
+    }
+}
+
+void test_solve_operation_2d_cholesky()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd m = a * a.transpose() +
+        42.0 * Eigen::MatrixXd::Identity(42, 42);
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(42, 5);
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    phylanx::execution_tree::primitive solve =
+        hpx::new_<phylanx::execution_tree::primitives::solve_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), phylanx::ir::node_data<double>(b),
+                std::string("cholesky")
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        solve.eval();
+
+    Eigen::MatrixXd expected = m.llt().solve(b);
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_solve_operation_store()
+{
+    Eigen::MatrixXd m1 = Eigen::MatrixXd::Random(42, 42);
+    Eigen::MatrixXd m2 = Eigen::MatrixXd::Random(42, 42);
+    Eigen::VectorXd v = Eigen::VectorXd::Random(42);
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(m1));
+
+    phylanx::execution_tree::primitive solve =
+        hpx::new_<phylanx::execution_tree::primitives::solve_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                lhs, phylanx::ir::node_data<double>(v)
+            });
+
+    phylanx::execution_tree::primitive store =
+        hpx::new_<phylanx::execution_tree::primitives::store_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                lhs, phylanx::ir::node_data<double>(m2)
+            });
+
+    Eigen::VectorXd expected = m1.partialPivLu().solve(v);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(solve.eval().get()));
+
+    // storing a new matrix invalidates the decomposition of the old one
+    store.eval().get();
+
+    expected = m2.partialPivLu().solve(v);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(solve.eval().get()));
+}
+
+void test_solve_operation_inverse()
+{
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(42, 42);
+    Eigen::VectorXd v = Eigen::VectorXd::Random(42);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"A", phylanx::ir::node_data<double>(m)},
+        {"b", phylanx::ir::node_data<double>(v)}
+    };
+
+    // dot(inverse(A), b) is computed by solving the system
+    phylanx::execution_tree::primitive_argument_type p =
+        phylanx::execution_tree::generate_tree("dot(inverse(A), b)",
+            phylanx::execution_tree::variables(vars));
+
+    Eigen::VectorXd expected = m.partialPivLu().solve(v);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::numeric_operand(p).get());
+}
+
+phylanx::ir::node_data<double> evaluate(char const* expr,
+    phylanx::execution_tree::variables::map_type const& vars)
+{
+    auto p = phylanx::execution_tree::generate_tree(
+        expr, phylanx::execution_tree::variables(vars));
+    return phylanx::execution_tree::numeric_operand(p).get();
+}
+
+void test_solve_operation_inverse_unchanged()
+{
+    // a singular matrix is inverted as written
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(42, 42);
+    m.row(3).setZero();
+    Eigen::VectorXd v = Eigen::VectorXd::Random(42);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"A", phylanx::ir::node_data<double>(m)},
+        {"b", phylanx::ir::node_data<double>(v)},
+        {"x", phylanx::ir::node_data<double>(4.0)},
+        {"y", phylanx::ir::node_data<double>(3.0)}
+    };
+
+    Eigen::MatrixXd inverse = m.inverse();
+    Eigen::MatrixXd expected = inverse * v;
+    phylanx::ir::node_data<double> result =
+        evaluate("dot(inverse(A), b)", vars);
+    HPX_TEST(!expected.allFinite());
+    HPX_TEST((result.matrix().array().isFinite() ==
+        expected.array().isFinite()).all());
+
+    // 0-dimensional values
+    HPX_TEST_EQ(phylanx::ir::node_data<double>((1 / 4.0) * 3.0),
+        evaluate("dot(inverse(x), y)", vars));
+
+    bool caught_exception = false;
+    try
+    {
+        evaluate("dot(inverse(x), b)", vars);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int main(int argc, char* argv[])
+{
+    test_solve_operation_0d();
+
+    test_solve_operation_2d_lu();
+    test_solve_operation_2d_cholesky();
+
+    test_solve_operation_store();
+    test_solve_operation_inverse();
+    test_solve_operation_inverse_unchanged();
+
+    return hpx::util::report_errors();
+}
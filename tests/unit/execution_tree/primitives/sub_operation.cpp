@@ -11,6 +11,8 @@
 
 #include <Eigen/Dense>
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -165,6 +167,63 @@ void test_sub_operation_2d_lit()
         phylanx::execution_tree::extract_numeric_value(f.get()));
 }
 
+void test_sub_operation_2d_many(std::size_t count)
+{
+    // integral values are subtracted exactly in any order
+    std::vector<phylanx::execution_tree::primitive_argument_type> operands;
+    Eigen::MatrixXd expected;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        Eigen::MatrixXd m = (100.0 * Eigen::MatrixXd::Random(101, 101)).array()
+            .round();
+        if (i == 0)
+        {
+            expected = m;
+        }
+        else
+        {
+            expected.array() -= m.array();
+        }
+        operands.push_back(phylanx::ir::node_data<double>(std::move(m)));
+    }
+
+    phylanx::execution_tree::primitive sub =
+        hpx::new_<phylanx::execution_tree::primitives::sub_operation>(
+            hpx::find_here(), std::move(operands));
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        sub.eval();
+
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_sub_operation_mask()
+{
+    // boolean masks are subtracted as int64, the result doesn't wrap around
+    std::vector<std::uint8_t> m1 = {0, 1, 1, 0};
+    std::vector<std::uint8_t> m2 = {1, 1, 0, 0};
+
+    phylanx::execution_tree::primitive sub =
+        hpx::new_<phylanx::execution_tree::primitives::sub_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<std::uint8_t>(m1),
+                phylanx::ir::node_data<std::uint8_t>(m2)
+            });
+
+    phylanx::execution_tree::primitive_result_type result = sub.eval().get();
+
+    auto const* value =
+        phylanx::util::get_if<phylanx::ir::node_data<std::int64_t>>(&result);
+    HPX_TEST(value != nullptr);
+
+    std::vector<std::int64_t> expected = {-1, 0, 1, 0};
+    HPX_TEST_EQ(phylanx::ir::node_data<std::int64_t>(std::move(expected)),
+        *value);
+}
+
 int main(int argc, char* argv[])
 {
     test_sub_operation_0d();
@@ -176,5 +235,10 @@ int main(int argc, char* argv[])
     test_sub_operation_2d();
     test_sub_operation_2d_lit();
 
+    test_sub_operation_2d_many(3);
+    test_sub_operation_2d_many(64);
+
+    test_sub_operation_mask();
+
     return hpx::util::report_errors();
 }
@@ -0,0 +1,173 @@
+//  Copyright (c) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using shape_type = phylanx::ir::node_data<double>::shape_type;
+using phylanx::execution_tree::static_shape;
+
+///////////////////////////////////////////////////////////////////////////////
+bool rejects(std::string const& name, std::vector<static_shape> const& shapes)
+{
+    try
+    {
+        phylanx::execution_tree::infer_shape(name, shapes);
+    }
+    catch (hpx::exception const&)
+    {
+        return true;
+    }
+    return false;
+}
+
+void test_infer_shape()
+{
+    using phylanx::execution_tree::infer_shape;
+
+    static_shape scalar(shape_type{});
+    static_shape vector(shape_type{4});
+    static_shape matrix(shape_type{3, 4});
+    static_shape unknown;
+
+    HPX_TEST(infer_shape("add", {matrix, matrix}) == matrix);
+    HPX_TEST(infer_shape("sub", {scalar, vector}) == vector);
+    HPX_TEST(infer_shape("div", {matrix, scalar}) == matrix);
+    HPX_TEST(!infer_shape("add", {matrix, unknown}));
+    HPX_TEST(rejects("add", {vector, matrix}));
+    HPX_TEST(rejects("sub", {matrix, static_shape(shape_type{4, 3})}));
+    HPX_TEST(rejects("add", {matrix, scalar, scalar}));
+
+    HPX_TEST(infer_shape("dot", {vector, vector}) == scalar);
+    HPX_TEST(infer_shape("dot", {matrix, vector}) ==
+        static_shape(shape_type{3}));
+    HPX_TEST(infer_shape("dot", {matrix, static_shape(shape_type{4, 2})}) ==
+        static_shape(shape_type{3, 2}));
+    HPX_TEST(rejects("dot", {matrix, matrix}));
+    HPX_TEST(rejects("dot", {scalar, vector}));
+
+    HPX_TEST(infer_shape("mul", {scalar, matrix}) == matrix);
+    HPX_TEST(infer_shape("mul", {matrix, scalar}) == matrix);
+    HPX_TEST(rejects("mul", {matrix, matrix}));
+
+    static_shape square(shape_type{4, 4});
+    HPX_TEST(infer_shape("solve", {square, vector}) == vector);
+    HPX_TEST(infer_shape("solve", {square, static_shape(shape_type{4, 2})}) ==
+        static_shape(shape_type{4, 2}));
+    HPX_TEST(infer_shape("solve", {scalar, matrix}) == matrix);
+    HPX_TEST(rejects("solve", {matrix, vector}));
+    HPX_TEST(rejects("solve", {square, matrix}));
+    HPX_TEST(infer_shape("lu", {square}) == square);
+    HPX_TEST(infer_shape("cholesky", {scalar}) == scalar);
+    HPX_TEST(rejects("cholesky", {matrix}));
+
+    HPX_TEST(infer_shape("transpose", {matrix}) ==
+        static_shape(shape_type{4, 3}));
+    HPX_TEST(infer_shape("unary_minus", {vector}) == vector);
+    HPX_TEST(rejects("exp", {matrix}));
+
+    // shapes of other operations are not known
+    HPX_TEST(!infer_shape("less", {matrix, matrix}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> evaluate(char const* expr,
+    phylanx::execution_tree::variables::map_type const& vars)
+{
+    auto p = phylanx::execution_tree::generate_tree(
+        expr, phylanx::execution_tree::variables(vars));
+    return phylanx::execution_tree::numeric_operand(p).get();
+}
+
+bool rejected(char const* expr,
+    phylanx::execution_tree::variables::map_type const& vars)
+{
+    try
+    {
+        phylanx::execution_tree::generate_tree(
+            expr, phylanx::execution_tree::variables(vars));
+    }
+    catch (hpx::exception const&)
+    {
+        return true;
+    }
+    return false;
+}
+
+void test_generate_tree()
+{
+    Eigen::MatrixXd a = Eigen::MatrixXd::Random(3, 4);
+    Eigen::MatrixXd b = Eigen::MatrixXd::Random(3, 4);
+    Eigen::MatrixXd c = Eigen::MatrixXd::Random(4, 3);
+
+    phylanx::execution_tree::variables::map_type vars = {
+        {"A", phylanx::ir::node_data<double>(a)},
+        {"B", phylanx::ir::node_data<double>(b)},
+        {"C", phylanx::ir::node_data<double>(c)},
+        {"x", phylanx::ir::node_data<double>(0.5)}
+    };
+
+    // incompatible shapes are reported while generating the tree
+    HPX_TEST(rejected("A + C", vars));
+    HPX_TEST(rejected("x * (A - transpose(B))", vars));
+    HPX_TEST(rejected("dot(A, B)", vars));
+    HPX_TEST(rejected("dot(C, A) + A", vars));
+
+    // the shapes of modified variables are not known
+    HPX_TEST(!rejected("block(store(A, C), A + C)", vars));
+
+    // code which is evaluated conditionally reports invalid shapes only if
+    // it is actually evaluated
+    HPX_TEST(!rejected("if(x < 0.0, A + C, A + B)", vars));
+    HPX_TEST(!rejected("while(x < 0.0, store(x, dot(A, B)))", vars));
+    HPX_TEST(rejected("if(A + C, A, B)", vars));
+
+    bool caught_exception = false;
+    try
+    {
+        evaluate("if(x > 0.0, A + C, A + B)", vars);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    // operations on values of known shapes
+    Eigen::MatrixXd expected = a + b;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("A + B", vars));
+
+    expected = (-(0.5 * a + b)).transpose();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("transpose(-(x * A + B))", vars));
+
+    expected = a * c - 2.0 * (c.transpose() * b.transpose()).transpose();
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("dot(A, C) - 2.0 * transpose(dot(transpose(C), "
+            "transpose(B)))", vars));
+
+    expected = c + c;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("block(store(A, C), A + C)", vars));
+
+    expected = a + b;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        evaluate("if(x < 0.0, A + C, A + B)", vars));
+}
+
+int main(int argc, char* argv[])
+{
+    test_infer_shape();
+    test_generate_tree();
+
+    return hpx::util::report_errors();
+}
@@ -6,15 +6,24 @@
 #include <phylanx/phylanx.hpp>
 
 #include <hpx/hpx_main.hpp>
+#include <hpx/include/serialization.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
-void test_serialization(phylanx::ir::node_data<double> const& array_value1)
+template <typename T>
+void test_serialization(phylanx::ir::node_data<T> const& array_value1)
 {
-    phylanx::ir::node_data<double> array_value2;
+    phylanx::ir::node_data<T> array_value2;
 
     std::vector<char> buffer = phylanx::util::serialize(array_value1);
     phylanx::util::detail::unserialize(buffer, array_value2);
@@ -22,6 +31,26 @@ void test_serialization(phylanx::ir::node_data<double> const& array_value1)
     HPX_TEST(array_value1 == array_value2);
 }
 
+// archives written before node_data had a format version hold the data in
+// the format used for Eigen matrices
+void test_legacy_serialization()
+{
+    Eigen::MatrixXd m = Eigen::MatrixXd::Random(7, 5);
+
+    std::vector<char> buffer;
+    std::size_t archive_size = 0;
+    {
+        hpx::serialization::output_archive archive(buffer);
+        archive << m;
+        archive_size = archive.bytes_written();
+    }
+    buffer.resize(archive_size);
+
+    phylanx::ir::node_data<double> array_value;
+    phylanx::util::detail::unserialize(buffer, array_value);
+    HPX_TEST(array_value == phylanx::ir::node_data<double>(m));
+}
+
 int main(int argc, char* argv[])
 {
     {
@@ -40,6 +69,23 @@ int main(int argc, char* argv[])
             phylanx::ir::node_data<double>::dimensions_type({1, 1}));
 
         test_serialization(single_value);
+
+        // 0-dimensional values are stored inline
+        HPX_TEST(single_value.is_scalar());
+        HPX_TEST(!single_value.is_shared());
+
+        phylanx::ir::node_data<double> single_value2(single_value);
+        single_value2[0] = 43.0;
+        HPX_TEST_EQ(single_value[0], 42.0);
+        HPX_TEST_EQ(single_value2[0], 43.0);
+
+        // requesting mutable access to the matrix moves the value to the heap
+        single_value2.matrix()(0, 0) += 1.0;
+        HPX_TEST(!single_value2.is_scalar());
+        HPX_TEST_EQ(single_value2[0], 44.0);
+        HPX_TEST_EQ(single_value2.num_dimensions(), std::size_t(0));
+
+        test_serialization(single_value2);
     }
 
     {
@@ -98,5 +144,266 @@ int main(int argc, char* argv[])
         test_serialization(array_value);
     }
 
+    {
+        Eigen::VectorXd v = Eigen::VectorXd::Random(1007);
+
+        phylanx::ir::node_data<double> array_value1(v);
+        phylanx::ir::node_data<double> array_value2(array_value1);
+
+        phylanx::ir::node_data<double> const& cvalue1 = array_value1;
+        phylanx::ir::node_data<double> const& cvalue2 = array_value2;
+
+        // copies share the same data
+        HPX_TEST(array_value1.is_shared());
+        HPX_TEST(array_value2.is_shared());
+        HPX_TEST_EQ(cvalue1.data(), cvalue2.data());
+
+        // modifying one of the copies detaches it from the shared data
+        array_value2[0] = v[0] + 1.0;
+
+        HPX_TEST(!array_value1.is_shared());
+        HPX_TEST(!array_value2.is_shared());
+        HPX_TEST_NEQ(cvalue1.data(), cvalue2.data());
+
+        HPX_TEST_EQ(cvalue1[0], v[0]);
+        HPX_TEST_EQ(cvalue2[0], v[0] + 1.0);
+        HPX_TEST(std::equal(hpx::util::begin(array_value1) + 1,
+            hpx::util::end(array_value1), hpx::util::begin(array_value2) + 1));
+
+        test_serialization(array_value1);
+    }
+
+    {
+        std::vector<double> v(12);
+        std::iota(v.begin(), v.end(), 0.0);
+
+        phylanx::ir::node_data<double> view_value(
+            v.data(), phylanx::ir::node_data<double>::dimensions_type{3, 4});
+        phylanx::ir::node_data<double> const& cview = view_value;
+
+        // views refer to the external memory without copying it
+        HPX_TEST(view_value.is_view());
+        HPX_TEST_EQ(cview.data(), v.data());
+        HPX_TEST_EQ(view_value.num_dimensions(), std::size_t(2));
+        HPX_TEST_EQ(view_value.dimension(0), std::size_t(3));
+        HPX_TEST_EQ(view_value.dimension(1), std::size_t(4));
+        HPX_TEST_EQ(cview.matrix().data(), v.data());
+        HPX_TEST_EQ(cview[phylanx::ir::node_data<double>::dimensions_type{
+            1, 2}], v[7]);
+        HPX_TEST(std::equal(hpx::util::begin(view_value),
+            hpx::util::end(view_value), v.begin()));
+
+        test_serialization(view_value);
+
+        // modifying a view makes a private copy, the external memory is
+        // left untouched
+        phylanx::ir::node_data<double> copied_value(view_value);
+        copied_value[0] = 42.0;
+
+        HPX_TEST(!copied_value.is_view());
+        HPX_TEST(view_value.is_view());
+        HPX_TEST_EQ(v[0], 0.0);
+        HPX_TEST_EQ(copied_value[0], 42.0);
+        HPX_TEST(std::equal(hpx::util::begin(copied_value) + 1,
+            hpx::util::end(copied_value), v.begin() + 1));
+    }
+
+    {
+        std::shared_ptr<std::vector<double>> v =
+            std::make_shared<std::vector<double>>(100, 1.0);
+        std::weak_ptr<std::vector<double>> wv = v;
+
+        phylanx::ir::node_data<double> view_value(v->data(),
+            phylanx::ir::node_data<double>::dimensions_type{100, 1}, v);
+        v.reset();
+
+        // the keep-alive handle is released with the last referring instance
+        HPX_TEST(!wv.expired());
+        HPX_TEST_EQ(view_value.num_dimensions(), std::size_t(1));
+        HPX_TEST_EQ(view_value[99], 1.0);
+
+        view_value = phylanx::ir::node_data<double>();
+        HPX_TEST(wv.expired());
+    }
+
+    {
+        static_assert(std::is_same<phylanx::ir::promoted_type_t<
+            std::uint8_t, std::int64_t>, std::int64_t>::value, "");
+        static_assert(std::is_same<phylanx::ir::promoted_type_t<
+            std::int64_t, float>, double>::value, "");
+        static_assert(std::is_same<phylanx::ir::promoted_type_t<
+            float, float>, float>::value, "");
+        static_assert(std::is_same<phylanx::ir::promoted_type_t<
+            double, std::uint8_t>, double>::value, "");
+
+        Eigen::MatrixXf m = Eigen::MatrixXf::Random(17, 9);
+        phylanx::ir::node_data<float> float_value(m);
+
+        HPX_TEST_EQ(float_value.num_dimensions(), std::size_t(2));
+        test_serialization(float_value);
+
+        // converting to a different element type copies the data
+        phylanx::ir::node_data<double> double_value(float_value);
+        HPX_TEST(double_value.dimensions() == float_value.dimensions());
+        for (std::size_t i = 0; i != double_value.size(); ++i)
+        {
+            HPX_TEST_EQ(double_value[i], double(float_value[i]));
+        }
+
+        phylanx::ir::node_data<std::int64_t> int_value(std::int64_t(42));
+        HPX_TEST(int_value.is_scalar());
+        HPX_TEST_EQ(phylanx::ir::node_data<double>(int_value)[0], 42.0);
+        test_serialization(int_value);
+
+        std::vector<std::uint8_t> mask = {0, 1, 0, 0};
+        phylanx::ir::node_data<std::uint8_t> mask_value(mask);
+        HPX_TEST(bool(mask_value));
+        HPX_TEST_EQ(mask_value.num_dimensions(), std::size_t(1));
+        test_serialization(mask_value);
+
+        mask_value[1] = 0;
+        HPX_TEST(!mask_value);
+    }
+
+    {
+        std::vector<double> v(24);
+        std::iota(v.begin(), v.end(), 0.0);
+
+        using shape_type = phylanx::ir::node_data<double>::shape_type;
+
+        phylanx::ir::node_data<double> array_value(v);
+        phylanx::ir::node_data<double> tensor_value =
+            array_value.reshape({2, 3, 4});
+        phylanx::ir::node_data<double> const& carray = array_value;
+        phylanx::ir::node_data<double> const& ctensor = tensor_value;
+
+        // reshaping does not copy the data
+        HPX_TEST_EQ(ctensor.data(), carray.data());
+        HPX_TEST_EQ(tensor_value.num_dimensions(), std::size_t(3));
+        HPX_TEST(tensor_value.shape() == shape_type({2, 3, 4}));
+        HPX_TEST(tensor_value.strides() == shape_type({1, 2, 6}));
+        HPX_TEST(tensor_value.dimensions() ==
+            phylanx::ir::node_data<double>::dimensions_type({2, 12}));
+        HPX_TEST_EQ(tensor_value.at({1, 2, 3}), 23.0);
+
+        test_serialization(tensor_value);
+
+        // permuting does not copy the data either
+        phylanx::ir::node_data<double> permuted_value =
+            tensor_value.permute({2, 0, 1});
+
+        HPX_TEST(!permuted_value.is_contiguous());
+        HPX_TEST(permuted_value.shape() == shape_type({4, 2, 3}));
+        HPX_TEST(permuted_value.strides() == shape_type({6, 1, 2}));
+        HPX_TEST_EQ(permuted_value.at({3, 1, 2}), 23.0);
+
+        phylanx::ir::node_data<double> contiguous_value =
+            permuted_value.contiguous();
+
+        // the const accessors of a permuted array refer to a contiguous copy
+        // of its elements, which is created once
+        phylanx::ir::node_data<double> const& const_value = permuted_value;
+        HPX_TEST(std::equal(const_value.begin(), const_value.end(),
+            contiguous_value.begin()));
+        HPX_TEST_EQ(const_value.data(), const_value.data());
+        HPX_TEST(const_value.data() != ctensor.data());
+        HPX_TEST(!permuted_value.is_contiguous());
+
+        HPX_TEST(contiguous_value.is_contiguous());
+        HPX_TEST(contiguous_value == permuted_value);
+        for (std::ptrdiff_t i = 0; i != 4; ++i)
+        {
+            for (std::ptrdiff_t j = 0; j != 2; ++j)
+            {
+                for (std::ptrdiff_t k = 0; k != 3; ++k)
+                {
+                    HPX_TEST_EQ(contiguous_value.at({i, j, k}),
+                        tensor_value.at({j, k, i}));
+                }
+            }
+        }
+
+        test_serialization(permuted_value);
+
+        // modifying a reshaped array leaves the original untouched
+        phylanx::ir::node_data<double> matrix_value =
+            array_value.reshape({6, 4});
+        HPX_TEST_EQ(matrix_value.num_dimensions(), std::size_t(2));
+
+        matrix_value.matrix()(5, 3) = 42.0;
+        HPX_TEST_EQ(matrix_value[23], 42.0);
+        HPX_TEST_EQ(array_value[23], 23.0);
+        HPX_TEST_EQ(matrix_value.dimension(0), std::size_t(6));
+    }
+
+    {
+        Eigen::SparseMatrix<double> m(100, 80);
+        m.insert(3, 4) = 1.5;
+        m.insert(99, 79) = -2.0;
+        m.makeCompressed();
+
+        phylanx::ir::node_data<double> sparse_value(m);
+        phylanx::ir::node_data<double> const& cvalue = sparse_value;
+
+        HPX_TEST(sparse_value.is_sparse());
+        HPX_TEST_EQ(sparse_value.num_dimensions(), std::size_t(2));
+        HPX_TEST_EQ(cvalue.sparse_matrix().nonZeros(), 2);
+
+        // dense accessors see all elements
+        HPX_TEST_EQ(cvalue[phylanx::ir::node_data<double>::dimensions_type{
+            3, 4}], 1.5);
+        HPX_TEST_EQ(cvalue.matrix()(99, 79), -2.0);
+        HPX_TEST_EQ(cvalue.matrix()(0, 0), 0.0);
+
+        test_serialization(sparse_value);
+
+        // modifying the sparse data of a copy leaves the original untouched
+        phylanx::ir::node_data<double> sparse_copy(sparse_value);
+        sparse_copy.sparse_matrix().coeffRef(3, 4) = 42.0;
+        HPX_TEST_EQ(cvalue.sparse_matrix().coeff(3, 4), 1.5);
+        HPX_TEST(sparse_copy.is_sparse());
+
+        // mutable dense access converts the data to a dense array
+        sparse_copy[0] = 1.0;
+        HPX_TEST(!sparse_copy.is_sparse());
+        HPX_TEST_EQ(sparse_copy[0], 1.0);
+        HPX_TEST_EQ(sparse_copy.matrix()(3, 4), 42.0);
+    }
+
+    {
+        Eigen::MatrixXd m = Eigen::MatrixXd::Random(17, 23);
+        phylanx::ir::node_data<double> array_value(m);
+
+        phylanx::ir::get_node_data_pool_statistics(true);
+
+        double const* buffer = nullptr;
+        std::uint64_t identity = 0;
+        {
+            phylanx::ir::node_data<double> array_copy(array_value);
+            HPX_TEST_EQ(array_copy.identity(), array_value.identity());
+
+            array_copy[0] = 1.0;
+            buffer = array_copy.data();
+            identity = array_copy.identity();
+            HPX_TEST_NEQ(identity, array_value.identity());
+        }
+
+        // the buffer of the released copy is reused for the next array of
+        // the same size
+        phylanx::ir::node_data<double> array_copy(array_value);
+        array_copy[0] = 2.0;
+        HPX_TEST_EQ(static_cast<double const*>(array_copy.data()), buffer);
+        HPX_TEST_NEQ(array_copy.identity(), identity);
+        HPX_TEST_EQ(array_copy.matrix()(16, 22), m(16, 22));
+        HPX_TEST_EQ(array_value[0], m(0, 0));
+
+        phylanx::ir::node_data_pool_statistics stats =
+            phylanx::ir::get_node_data_pool_statistics();
+        HPX_TEST_LTE(std::uint64_t(1), stats.hits);
+        HPX_TEST_EQ(stats.hits + stats.misses, std::uint64_t(2));
+    }
+
+    test_legacy_serialization();
+
     return hpx::util::report_errors();
 }